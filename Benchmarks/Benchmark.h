@@ -0,0 +1,43 @@
+#pragma once
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Benchmark
+{
+	// Forces the value to be materialized so measured work is not optimized away
+	template<typename T>
+	inline void DoNotOptimize(const T& value)
+	{
+#if defined(_MSC_VER)
+		static volatile const void* sink;
+		sink = &value;
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : "r"(&value) : "memory");
+#endif
+	}
+
+	// Runs function given number of times and prints average time of single run
+	template<typename Function>
+	inline double Measure(const std::string& name, const size_t iterations, Function&& function)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < iterations; ++i)
+		{
+			function();
+		}
+		const auto end = std::chrono::steady_clock::now();
+		const auto nanoseconds = std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(iterations);
+		std::cout << std::left << std::setw(48) << name << std::right << std::setw(12) << std::fixed << std::setprecision(2) << nanoseconds << " ns/op" << std::endl;
+		return nanoseconds;
+	}
+}
+
+void RunValueBenchmarks();
+void RunLexerBenchmarks();
+void RunInterpreterBenchmarks();
@@ -0,0 +1,51 @@
+#include "Benchmark.h"
+#include "Interpreter.h"
+#include "Parser.h"
+
+namespace
+{
+	constexpr size_t iterations = 20;
+
+	// Loop body is dominated by standard expressions of a few operators each
+	const std::wstring expressionLoop = LR"(
+	func Main()
+	{
+		mut var i = 10000;
+		mut var sum = 0;
+		while (i > 0)
+		{
+			var a = i * 3 + 7;
+			var b = -(a - i) / 2;
+			sum = sum + a / 5 + b;
+			if (a > 100 && b < 0 || !(i == 3))
+			{
+				sum = sum - 1;
+			}
+			else
+			{
+				sum = sum + 1;
+			}
+			i = i - 1;
+		}
+		return 0;
+	}
+	)";
+
+	std::unique_ptr<Program> ParseProgram(const std::wstring& code)
+	{
+		Lexer lexer(std::wstring_view{ code });
+		const auto tokens = lexer.Tokenize();
+		return Parser(&tokens).ParseProgram();
+	}
+}
+
+void RunInterpreterBenchmarks()
+{
+	std::cout << std::endl << "Interpreting 10000 iterations of expression heavy loop" << std::endl;
+	const auto program = ParseProgram(expressionLoop);
+	Benchmark::Measure("tree walking interpreter", iterations, [&]()
+	{
+		Interpreter interpreter;
+		interpreter.Interpret(program.get());
+	});
+}
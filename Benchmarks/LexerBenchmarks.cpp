@@ -0,0 +1,192 @@
+#include "Benchmark.h"
+#include "Lexer.h"
+#include "MappedFile.h"
+#include "Parser.h"
+#include "ParallelParser.h"
+#include "ProgramImage.h"
+#include "StringConversion.h"
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+	constexpr size_t iterations = 10;
+	constexpr size_t scriptLines = 100'000;
+	constexpr size_t textIterations = 200;
+	constexpr size_t textLines = 1'000;
+
+	// Generated scripts are what the mapped UTF-8 input is aimed at
+	std::filesystem::path WriteGeneratedScript()
+	{
+		const auto path = std::filesystem::temp_directory_path() / "InterpreterLexerBenchmark.txt";
+		std::ofstream file(path, std::ios::binary);
+		for (size_t i = 0; i < scriptLines; ++i)
+		{
+			file << "mut var value" << i << " = " << i << " * 2.5 + \"text " << i << "\"; # generated line\n";
+		}
+		return path;
+	}
+
+	std::wstring RepeatLine(const std::wstring& line)
+	{
+		std::wstring text;
+		for (size_t i = 0; i < textLines; ++i)
+		{
+			text += line;
+		}
+		return text;
+	}
+
+	void MeasureInPlaceLexing(const std::string& name, const std::wstring& text)
+	{
+		Benchmark::Measure(name, textIterations, [&text]()
+		{
+			Lexer lexer(std::wstring_view{ text });
+			Benchmark::DoNotOptimize(lexer.ResolveAllRemaining());
+		});
+	}
+
+	std::wstring GeneratedProgram()
+	{
+		std::wstring text = L"func Main()\n{\n";
+		for (size_t i = 0; i < textLines; ++i)
+		{
+			text += L"\tmut var value" + std::to_wstring(i) + L" = " + std::to_wstring(i) + L" * 2.5 + \"text\"; # generated line\n";
+		}
+		return text + L"}\n";
+	}
+
+	std::wstring GeneratedFunctions()
+	{
+		std::wstring text;
+		for (size_t i = 0; i < textLines; ++i)
+		{
+			text += L"func Function" + std::to_wstring(i) + L"(a, b)\n{\n\tmut var value = a * 2.5 + \"text\"; # generated line\n\treturn value + b;\n}\n";
+		}
+		return text;
+	}
+
+	std::wstring GeneratedExpressions()
+	{
+		std::wstring text = L"func Main(a, b)\n{\n";
+		for (size_t i = 0; i < textLines; ++i)
+		{
+			const auto number = std::to_wstring(i);
+			text += L"\tvar value" + number + L" = (a + " + number + L") * b - " + number + L" / 2 < a * 3 && !(b == " + number + L") || -a + b >= " + number + L";\n";
+		}
+		return text + L"}\n";
+	}
+}
+
+void RunLexerBenchmarks()
+{
+	std::cout << "Lexing " << textLines << " lines of in memory text" << std::endl;
+	MeasureInPlaceLexing("keywords", RepeatLine(L"mut var while if else return func true false\n"));
+	MeasureInPlaceLexing("identifiers", RepeatLine(L"alpha beta gamma_1 delta epsilon zeta eta theta\n"));
+	MeasureInPlaceLexing("operators", RepeatLine(L"a && b || c == d != e <= f >= g += h << i >> j;\n"));
+	MeasureInPlaceLexing("string literals", RepeatLine(L"\"first\" \"second literal\" \"escaped \\\"text\\\"\\n\" \"\"\n"));
+	MeasureInPlaceLexing("single symbols", RepeatLine(L"( ) { } [ ] , ; = + - * / ! < >\n"));
+	MeasureInPlaceLexing("indentation and comments", RepeatLine(L"\t\t\t\t    value; # " + std::wstring(120, L'-') + L"\n\n"));
+	MeasureInPlaceLexing("long string literals", RepeatLine(L"\"" + std::wstring(120, L's') + L"\" \"" + std::wstring(60, L't') + L"\\n\"\n"));
+	MeasureInPlaceLexing("mixed statements", RepeatLine(L"mut var value = func(a, b) { return a * 2.5 + \"text\"; };\n"));
+
+	std::cout << "Parsing " << textLines << " generated lines of in memory text" << std::endl;
+	const auto program = GeneratedProgram();
+	Benchmark::Measure("lexing on demand", textIterations, [&program]()
+	{
+		Lexer lexer(std::wstring_view{ program });
+		Parser parser(&lexer);
+		Benchmark::DoNotOptimize(parser.ParseProgram());
+	});
+	Benchmark::Measure("token buffer", textIterations, [&program]()
+	{
+		Lexer lexer(std::wstring_view{ program });
+		const auto tokens = lexer.Tokenize();
+		Parser parser(&tokens);
+		Benchmark::DoNotOptimize(parser.ParseProgram());
+	});
+
+	std::cout << "Parsing " << textLines << " generated functions of in memory text" << std::endl;
+	const auto functions = GeneratedFunctions();
+	Benchmark::Measure("sequential", textIterations, [&functions]()
+	{
+		Lexer lexer(std::wstring_view{ functions });
+		const auto tokens = lexer.Tokenize();
+		Parser parser(&tokens);
+		Benchmark::DoNotOptimize(parser.ParseProgram());
+	});
+	{
+		Lexer lexer(std::wstring_view{ functions });
+		const auto tokens = lexer.Tokenize();
+		const auto program = Parser(&tokens).ParseProgram();
+		std::cout << "AST of " << program->funDefs.size() << " functions: " << program->arena.GetNodeCount() << " nodes, "
+			<< program->arena.GetByteCount() << " bytes" << std::endl;
+	}
+	Benchmark::Measure("ParallelParser, " + std::to_string(std::thread::hardware_concurrency()) + " threads", textIterations, [&functions]()
+	{
+		Benchmark::DoNotOptimize(ParallelParser().ParseProgram(std::wstring_view{ functions }));
+	});
+
+	std::cout << "Starting from " << textLines << " generated functions in file" << std::endl;
+	const auto sourcePath = (std::filesystem::temp_directory_path() / "InterpreterImageBenchmark.txt").string();
+	const auto imagePath = sourcePath + ".image";
+	std::ofstream(sourcePath, std::ios::binary) << StringConversion::ToNarrow(functions);
+	{
+		MappedFile file;
+		file.Open(sourcePath);
+		Lexer lexer(file.GetText());
+		const auto tokens = lexer.Tokenize();
+		ProgramImage::Write(*Parser(&tokens).ParseProgram(), ProgramImage::HashSource(file.GetText()), imagePath);
+	}
+	std::cout << "Image: " << std::filesystem::file_size(imagePath) << " bytes, source: " << std::filesystem::file_size(sourcePath) << " bytes" << std::endl;
+	Benchmark::Measure("lexing and parsing source", textIterations, [&sourcePath]()
+	{
+		MappedFile file;
+		file.Open(sourcePath);
+		Lexer lexer(file.GetText());
+		const auto tokens = lexer.Tokenize();
+		Parser parser(&tokens);
+		Benchmark::DoNotOptimize(parser.ParseProgram());
+	});
+	Benchmark::Measure("loading program image", textIterations, [&sourcePath, &imagePath]()
+	{
+		MappedFile file;
+		file.Open(sourcePath);
+		Benchmark::DoNotOptimize(ProgramImage::Load(imagePath, ProgramImage::HashSource(file.GetText())));
+	});
+	std::filesystem::remove(sourcePath);
+	std::filesystem::remove(imagePath);
+
+	std::cout << "Parsing " << textLines << " generated expression lines of in memory text" << std::endl;
+	const auto expressions = GeneratedExpressions();
+	Lexer expressionLexer(std::wstring_view{ expressions });
+	const auto expressionTokens = expressionLexer.Tokenize();
+	Benchmark::Measure("token buffer", textIterations, [&expressionTokens]()
+	{
+		Parser parser(&expressionTokens);
+		Benchmark::DoNotOptimize(parser.ParseProgram());
+	});
+	{
+		const auto program = Parser(&expressionTokens).ParseProgram();
+		std::cout << "AST: " << program->arena.GetNodeCount() << " nodes, " << program->arena.GetByteCount() << " bytes" << std::endl;
+	}
+
+	std::cout << "Lexing " << scriptLines << " generated lines from file" << std::endl;
+	const auto path = WriteGeneratedScript();
+
+	Benchmark::Measure("std::wifstream", iterations, [&path]()
+	{
+		std::wifstream file(path);
+		Lexer lexer(&file);
+		Benchmark::DoNotOptimize(lexer.ResolveAllRemaining());
+	});
+	Benchmark::Measure("MappedFile UTF-8", iterations, [&path]()
+	{
+		MappedFile file;
+		file.Open(path.string());
+		Lexer lexer(file.GetText());
+		Benchmark::DoNotOptimize(lexer.ResolveAllRemaining());
+	});
+
+	std::filesystem::remove(path);
+}
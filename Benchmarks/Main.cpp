@@ -0,0 +1,9 @@
+#include "Benchmark.h"
+
+int main()
+{
+	RunValueBenchmarks();
+	RunLexerBenchmarks();
+	RunInterpreterBenchmarks();
+	return 0;
+}
@@ -0,0 +1,86 @@
+#include "Benchmark.h"
+#include "Value.h"
+#include <vector>
+
+namespace
+{
+	constexpr size_t iterations = 2'000'000;
+
+	struct TypePair
+	{
+		std::string name;
+		Value lhs;
+		Value rhs;
+	};
+
+	std::vector<TypePair> ArithmeticPairs()
+	{
+		return {
+			{ "int/int", Value(12), Value(3) },
+			{ "float/float", Value(12.5f), Value(2.5f) },
+			{ "int/float", Value(12), Value(2.5f) },
+			{ "float/int", Value(12.5f), Value(3) },
+			{ "int/string", Value(12), Value(std::wstring(L"3")) },
+			{ "string/float", Value(std::wstring(L"12.5")), Value(2.5f) },
+			{ "string/string", Value(std::wstring(L"12")), Value(std::wstring(L"3")) },
+		};
+	}
+}
+
+void RunValueBenchmarks()
+{
+	std::cout << "Value binary operators" << std::endl;
+	for (const auto& pair : ArithmeticPairs())
+	{
+		Benchmark::Measure("operator+ " + pair.name, iterations, [&pair]() { Benchmark::DoNotOptimize(pair.lhs + pair.rhs); });
+		Benchmark::Measure("operator- " + pair.name, iterations, [&pair]() { Benchmark::DoNotOptimize(pair.lhs - pair.rhs); });
+		Benchmark::Measure("operator* " + pair.name, iterations, [&pair]() { Benchmark::DoNotOptimize(pair.lhs * pair.rhs); });
+		Benchmark::Measure("operator/ " + pair.name, iterations, [&pair]() { Benchmark::DoNotOptimize(pair.lhs / pair.rhs); });
+		Benchmark::Measure("operator== " + pair.name, iterations, [&pair]() { Benchmark::DoNotOptimize(pair.lhs == pair.rhs); });
+		Benchmark::Measure("operator> " + pair.name, iterations, [&pair]() { Benchmark::DoNotOptimize(pair.lhs > pair.rhs); });
+	}
+
+	const Value trueValue(true);
+	const Value falseValue(false);
+	Benchmark::Measure("operator== bool/bool", iterations, [&]() { Benchmark::DoNotOptimize(trueValue == falseValue); });
+
+	const Value text(std::wstring(L"text"));
+	Benchmark::Measure("operator+ string/string concatenation", iterations, [&]() { Benchmark::DoNotOptimize(text + text); });
+	Benchmark::Measure("operator+ bool/string concatenation", iterations, [&]() { Benchmark::DoNotOptimize(trueValue + text); });
+
+	std::cout << std::endl << "Mixed string/number arithmetic" << std::endl;
+	const Value word(std::wstring(L"abc"));
+	const Value intText(std::wstring(L"12"));
+	const Value floatText(std::wstring(L"2.5"));
+	const Value one(1);
+	const Value three(3);
+	Benchmark::Measure("string + int, not numeric", iterations, [&]() { Benchmark::DoNotOptimize(word + one); });
+	Benchmark::Measure("int + string, not numeric", iterations, [&]() { Benchmark::DoNotOptimize(one + word); });
+	Benchmark::Measure("string * int, repetition", iterations, [&]() { Benchmark::DoNotOptimize(word * three); });
+	Benchmark::Measure("string + int, int text", iterations, [&]() { Benchmark::DoNotOptimize(intText + one); });
+	Benchmark::Measure("string * int, float text", iterations, [&]() { Benchmark::DoNotOptimize(floatText * three); });
+	Benchmark::Measure("string > int, int text", iterations, [&]() { Benchmark::DoNotOptimize(intText > three); });
+	Benchmark::Measure("string == int, int text", iterations, [&]() { Benchmark::DoNotOptimize(intText == three); });
+
+	std::cout << std::endl << "String accumulation" << std::endl;
+	const Value piece(std::wstring(L"0123456789abcdef"));
+	const auto buildString = [&piece](const size_t bytes, const bool keepShared)
+	{
+		const auto pieces = bytes / (piece.GetString()->size() * sizeof(wchar_t));
+		Value text(std::wstring(L""));
+		Value sharedCopy;
+		for (size_t i = 0; i < pieces; ++i)
+		{
+			if (keepShared)
+			{
+				sharedCopy = text;
+			}
+			text += piece;
+		}
+		Benchmark::DoNotOptimize(text);
+	};
+	constexpr size_t megabyte = 1 << 20;
+	Benchmark::Measure("build 1 MB string, append in place", 10, [&]() { buildString(megabyte, false); });
+	Benchmark::Measure("build 64 KB string, append in place", 160, [&]() { buildString(megabyte / 16, false); });
+	Benchmark::Measure("build 64 KB string, copying shared", 10, [&]() { buildString(megabyte / 16, true); });
+}
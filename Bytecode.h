@@ -0,0 +1,117 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <optional>
+#include <unordered_map>
+#include "Position.h"
+#include "Symbol.h"
+#include "Value.h"
+
+enum class OpCode : uint8_t
+{
+	PushConstant,		// operand: constant index
+	PushFalse,
+	PushTrue,
+	Pop,
+
+	LoadLocal,			// operand: slot, error message as in Interpreter::EvaluateFactor
+	LoadLocalBindable,	// operand: slot, error message as in Interpreter::EvaluateBindable
+	LoadCallee,			// operand: slot, pushes function stored in the variable
+	DeclareLocal,		// operand: slot, pops initial value
+	DeclareLocalEmpty,	// operand: slot
+	AssignLocal,		// operand: slot, pops new value
+
+	LoadFunction,		// operand: function index, pushes named function as value
+	MakeFunction,		// operand: chunk index of function literal
+
+	Negate,
+	Not,
+	Add,
+	Subtract,
+	Multiply,
+	Divide,
+	Equal,
+	NotEqual,
+	Greater,
+	GreaterEqual,
+	Less,
+	LessEqual,
+	OrStep,
+	AndStep,
+
+	Compose,
+	Bind,				// operand: arguments count
+
+	CallNamed,			// operand: encoded call, see BytecodeCall
+	CallValue,			// operand: encoded call, callee lies below arguments
+	PushReturnValue,
+
+	Jump,				// operand: target
+	JumpIfTrue,			// operand: target, keeps the value on the stack
+	JumpIfFalse,		// operand: target, keeps the value on the stack
+	BranchIfFalse,		// operand: target, pops the value
+	JumpIfValueNotExpected,	// operand: target
+
+	SetReturnValue,
+	ReturnNoValue,
+
+	EnterBlock,
+	LeaveBlock,
+	TraceCallStatement,
+	TraceConditional,
+	TraceWhile,
+	Throw,				// operand: message index
+	End
+};
+
+struct Instruction
+{
+	OpCode opCode;
+	uint32_t operand = 0;
+};
+
+// Calls pack callee index, arguments count and whether value is expected into single operand
+namespace BytecodeCall
+{
+	constexpr uint32_t maxArguments = 0xFF;
+	constexpr uint32_t maxTarget = 0x7FFFFF;
+
+	constexpr uint32_t Encode(const uint32_t target, const uint32_t argumentsCount, const bool valueExpected) noexcept
+	{
+		return (argumentsCount << 24) | (static_cast<uint32_t>(valueExpected) << 23) | target;
+	}
+	constexpr uint32_t Target(const uint32_t operand) noexcept
+	{
+		return operand & maxTarget;
+	}
+	constexpr uint32_t ArgumentsCount(const uint32_t operand) noexcept
+	{
+		return operand >> 24;
+	}
+	constexpr bool ValueExpected(const uint32_t operand) noexcept
+	{
+		return (operand >> 23) & 1;
+	}
+}
+
+struct BytecodeChunk
+{
+	Symbol name;
+	Block* block = nullptr;
+	std::vector<Param> parameters;
+	std::vector<Symbol> slotNames;
+	std::vector<Instruction> code;
+	std::vector<Position> positions;
+	Position startingPosition = Position(0, 0);
+};
+
+struct BytecodeModule
+{
+	std::vector<BytecodeChunk> chunks;
+	std::vector<Value> constants;
+	std::vector<std::string> messages;
+	std::vector<size_t> functionChunks;
+	std::unordered_map<const Block*, size_t> chunkByBlock;
+	std::optional<size_t> mainFunction;
+};
@@ -0,0 +1,602 @@
+#include "BytecodeCompiler.h"
+#include "StringConversion.h"
+
+BytecodeModule BytecodeCompiler::Compile(const Program* const program)
+{
+	module = BytecodeModule();
+	functionIndices.clear();
+	pendingChunks.clear();
+	stringPool.Clear();
+
+	for (const auto& funDef : program->funDefs)
+	{
+		const auto functionIndex = static_cast<uint32_t>(module.functionChunks.size());
+		const auto chunkIndex = AddChunk(funDef->identifier, funDef->block.get(), funDef->parameters, funDef->startingPosition);
+		module.functionChunks.push_back(chunkIndex);
+		if (functionIndices.emplace(funDef->identifier, functionIndex).second && funDef->identifier == L"Main")
+		{
+			module.mainFunction = functionIndex;
+		}
+	}
+
+	while (!pendingChunks.empty())
+	{
+		const auto chunkIndex = pendingChunks.back();
+		pendingChunks.pop_back();
+		CompileChunk(chunkIndex);
+	}
+
+	return std::move(module);
+}
+
+size_t BytecodeCompiler::AddChunk(const Symbol name, Block* const block, const std::vector<Param>& parameters, const Position position)
+{
+	BytecodeChunk chunk;
+	chunk.name = name;
+	chunk.block = block;
+	chunk.parameters = parameters;
+	chunk.startingPosition = position;
+	module.chunks.push_back(std::move(chunk));
+
+	const auto chunkIndex = module.chunks.size() - 1;
+	module.chunkByBlock.emplace(block, chunkIndex);
+	pendingChunks.push_back(chunkIndex);
+	return chunkIndex;
+}
+
+void BytecodeCompiler::CompileChunk(const size_t chunkIndex)
+{
+	currentChunk = chunkIndex;
+	currentPosition = module.chunks[chunkIndex].startingPosition;
+	scopes.clear();
+	scopes.emplace_back();
+	for (const auto& param : module.chunks[chunkIndex].parameters)
+	{
+		DeclareLocal(param.identifier, param.paramMutable, true);
+	}
+
+	const auto block = module.chunks[chunkIndex].block;
+	if (!block)
+	{
+		throw CompilerException("Function does not have block.", currentPosition);
+	}
+	CompileBlock(block);
+	Emit(OpCode::End);
+	scopes.clear();
+}
+
+void BytecodeCompiler::CompileBlock(const Block* const block)
+{
+	currentPosition = block->startingPosition;
+	Emit(OpCode::EnterBlock);
+	scopes.emplace_back();
+	pendingBlockExits.emplace_back();
+	for (const auto& statement : block->statements)
+	{
+		CompileStatement(statement.get());
+		if (dynamic_cast<const Return*>(statement.get()))
+		{
+			break;
+		}
+	}
+	for (const auto exit : pendingBlockExits.back())
+	{
+		PatchJump(exit);
+	}
+	pendingBlockExits.pop_back();
+	scopes.pop_back();
+	Emit(OpCode::LeaveBlock);
+}
+
+void BytecodeCompiler::CompileStatement(const Statement* const statement)
+{
+	if (auto block = dynamic_cast<const Block*>(statement))
+	{
+		CompileBlock(block);
+	}
+	else if (auto functionCallStatement = dynamic_cast<const FunctionCallStatement*>(statement))
+	{
+		CompileFunctionCallStatement(functionCallStatement);
+	}
+	else if (auto whileLoop = dynamic_cast<const WhileLoop*>(statement))
+	{
+		CompileWhileLoop(whileLoop);
+	}
+	else if (auto returnStatement = dynamic_cast<const Return*>(statement))
+	{
+		CompileReturn(returnStatement);
+	}
+	else if (auto conditional = dynamic_cast<const Conditional*>(statement))
+	{
+		CompileConditional(conditional);
+	}
+	else if (auto declaration = dynamic_cast<const Declaration*>(statement))
+	{
+		CompileDeclaration(declaration);
+	}
+	else if (auto assignment = dynamic_cast<const Assignment*>(statement))
+	{
+		CompileAssignment(assignment);
+	}
+	else
+	{
+		throw CompilerException("Cannot compile such statement.", currentPosition);
+	}
+}
+
+void BytecodeCompiler::CompileFunctionCallStatement(const FunctionCallStatement* const functionCallStatement)
+{
+	currentPosition = functionCallStatement->startingPosition;
+	Emit(OpCode::TraceCallStatement);
+	CompileFunctionCall(functionCallStatement->funcCall.get(), false);
+}
+
+void BytecodeCompiler::CompileFunctionCall(const FunctionCall* const functionCall, const bool valueExpected)
+{
+	currentPosition = functionCall->startingPosition;
+	if (functionCall->arguments.size() > BytecodeCall::maxArguments)
+	{
+		throw CompilerException("Too many arguments in the function call.", currentPosition);
+	}
+	const auto argumentsCount = static_cast<uint32_t>(functionCall->arguments.size());
+
+	if (const auto functionIndex = FindFunction(functionCall->identifier))
+	{
+		CompileArguments(functionCall->arguments);
+		currentPosition = functionCall->startingPosition;
+		Emit(OpCode::CallNamed, BytecodeCall::Encode(*functionIndex, argumentsCount, valueExpected));
+		return;
+	}
+	if (const auto local = FindLocal(functionCall->identifier))
+	{
+		if (!local->initialized)
+		{
+			Emit(OpCode::Throw, AddMessage("Function definition not found."));
+			return;
+		}
+		Emit(OpCode::LoadCallee, local->slot);
+		CompileArguments(functionCall->arguments);
+		currentPosition = functionCall->startingPosition;
+		Emit(OpCode::CallValue, BytecodeCall::Encode(0, argumentsCount, valueExpected));
+		return;
+	}
+	Emit(OpCode::Throw, AddMessage("Function definition not found."));
+}
+
+void BytecodeCompiler::CompileWhileLoop(const WhileLoop* const whileLoop)
+{
+	currentPosition = whileLoop->startingPosition;
+	CompileStandardExpression(whileLoop->condition.get());
+	Emit(OpCode::TraceWhile);
+	const auto loopStart = module.chunks[currentChunk].code.size();
+	const auto exitJump = Emit(OpCode::BranchIfFalse);
+	CompileBlock(whileLoop->block.get());
+	CompileStandardExpression(whileLoop->condition.get());
+	Emit(OpCode::Jump, static_cast<uint32_t>(loopStart));
+	PatchJump(exitJump);
+}
+
+void BytecodeCompiler::CompileReturn(const Return* const returnStatement)
+{
+	currentPosition = returnStatement->startingPosition;
+	const auto notExpectedJump = Emit(OpCode::JumpIfValueNotExpected);
+	if (returnStatement->expression)
+	{
+		CompileExpression(returnStatement->expression.get());
+		Emit(OpCode::SetReturnValue);
+	}
+	else
+	{
+		Emit(OpCode::Throw, AddMessage("Function was expected to return value but returns nothing."));
+	}
+	pendingBlockExits.back().push_back(Emit(OpCode::Jump));
+	PatchJump(notExpectedJump);
+	Emit(OpCode::ReturnNoValue);
+	pendingBlockExits.back().push_back(Emit(OpCode::Jump));
+}
+
+void BytecodeCompiler::CompileConditional(const Conditional* const conditional)
+{
+	currentPosition = conditional->startingPosition;
+	CompileStandardExpression(conditional->condition.get());
+	Emit(OpCode::TraceConditional);
+	const auto elseJump = Emit(OpCode::BranchIfFalse);
+	CompileBlock(conditional->ifBlock.get());
+	if (conditional->elseBlock)
+	{
+		const auto endJump = Emit(OpCode::Jump);
+		PatchJump(elseJump);
+		CompileBlock(conditional->elseBlock.get());
+		PatchJump(endJump);
+	}
+	else
+	{
+		PatchJump(elseJump);
+	}
+}
+
+void BytecodeCompiler::CompileDeclaration(const Declaration* const declaration)
+{
+	currentPosition = declaration->startingPosition;
+	if (FindLocal(declaration->identifier))
+	{
+		Emit(OpCode::Throw, AddMessage("Redefinition of variable is not allowed."));
+		return;
+	}
+	if (FindFunction(declaration->identifier))
+	{
+		Emit(OpCode::Throw, AddMessage("Variable can not have the same name as function does."));
+		return;
+	}
+	const auto slot = DeclareLocal(declaration->identifier, declaration->varMutable, false);
+	if (declaration->expression)
+	{
+		CompileExpression(declaration->expression.get());
+		currentPosition = declaration->startingPosition;
+		Emit(OpCode::DeclareLocal, slot);
+	}
+	else
+	{
+		Emit(OpCode::DeclareLocalEmpty, slot);
+	}
+	// Variable declared without value may still be assigned later, so only the initializer sees it as empty
+	FindLocal(declaration->identifier)->initialized = true;
+}
+
+void BytecodeCompiler::CompileAssignment(const Assignment* const assignment)
+{
+	currentPosition = assignment->startingPosition;
+	const auto local = FindLocal(assignment->identifier);
+	if (!local)
+	{
+		Emit(OpCode::Throw, AddMessage("Variable was not declared."));
+		return;
+	}
+	if (!local->isMutable)
+	{
+		Emit(OpCode::Throw, AddMessage("Cannot assign to immutable variable."));
+		return;
+	}
+	const auto slot = local->slot;
+	CompileExpression(assignment->expression.get());
+	currentPosition = assignment->startingPosition;
+	Emit(OpCode::AssignLocal, slot);
+}
+
+void BytecodeCompiler::CompileExpression(const Expression* const expression)
+{
+	currentPosition = expression->startingPosition;
+	if (auto standardExpression = dynamic_cast<const StandardExpression*>(expression))
+	{
+		CompileStandardExpression(standardExpression);
+	}
+	else if (auto funcExpression = dynamic_cast<const FuncExpression*>(expression))
+	{
+		CompileFuncExpression(funcExpression);
+	}
+	else
+	{
+		throw CompilerException("Cannot compile such expression.", currentPosition);
+	}
+}
+
+void BytecodeCompiler::CompileStandardExpression(const StandardExpression* const expression)
+{
+	currentPosition = expression->startingPosition;
+	if (expression->conjunctions.size() == 1)
+	{
+		CompileConjunction(expression->conjunctions.front().get());
+		return;
+	}
+	std::vector<size_t> shortCircuits;
+	Emit(OpCode::PushFalse);
+	for (const auto& conjunction : expression->conjunctions)
+	{
+		CompileConjunction(conjunction.get());
+		Emit(OpCode::OrStep);
+		shortCircuits.push_back(Emit(OpCode::JumpIfTrue));
+	}
+	for (const auto jump : shortCircuits)
+	{
+		PatchJump(jump);
+	}
+}
+
+void BytecodeCompiler::CompileConjunction(const Conjunction* const conjunction)
+{
+	currentPosition = conjunction->startingPosition;
+	if (conjunction->relations.size() == 1)
+	{
+		CompileRelation(conjunction->relations.front().get());
+		return;
+	}
+	std::vector<size_t> shortCircuits;
+	Emit(OpCode::PushTrue);
+	for (const auto& relation : conjunction->relations)
+	{
+		CompileRelation(relation.get());
+		Emit(OpCode::AndStep);
+		shortCircuits.push_back(Emit(OpCode::JumpIfFalse));
+	}
+	for (const auto jump : shortCircuits)
+	{
+		PatchJump(jump);
+	}
+}
+
+void BytecodeCompiler::CompileRelation(const Relation* const relation)
+{
+	currentPosition = relation->startingPosition;
+	CompileAdditive(relation->firstAdditive.get());
+	if (!relation->relationOperator)
+	{
+		return;
+	}
+	CompileAdditive(relation->secondAdditive.get());
+	switch (*relation->relationOperator)
+	{
+	case RelationOperator::Equal:
+		Emit(OpCode::Equal);
+		break;
+	case RelationOperator::NotEqual:
+		Emit(OpCode::NotEqual);
+		break;
+	case RelationOperator::Greater:
+		Emit(OpCode::Greater);
+		break;
+	case RelationOperator::GreaterEqual:
+		Emit(OpCode::GreaterEqual);
+		break;
+	case RelationOperator::Less:
+		Emit(OpCode::Less);
+		break;
+	case RelationOperator::LessEqual:
+		Emit(OpCode::LessEqual);
+		break;
+	default:
+		throw CompilerException("Cannot handle such operator.", currentPosition);
+		break;
+	}
+}
+
+void BytecodeCompiler::CompileAdditive(const Additive* const additive)
+{
+	currentPosition = additive->startingPosition;
+	CompileMultiplicative(additive->multiplicatives.front().get());
+	for (size_t i = 0; i < additive->operators.size(); ++i)
+	{
+		CompileMultiplicative(additive->multiplicatives[i + 1].get());
+		switch (additive->operators[i])
+		{
+		case AdditionOperator::Plus:
+			Emit(OpCode::Add);
+			break;
+		case AdditionOperator::Minus:
+			Emit(OpCode::Subtract);
+			break;
+		default:
+			throw CompilerException("Cannot handle such operator.", currentPosition);
+			break;
+		}
+	}
+	if (additive->negated)
+	{
+		Emit(OpCode::Negate);
+	}
+}
+
+void BytecodeCompiler::CompileMultiplicative(const Multiplicative* const multiplicative)
+{
+	currentPosition = multiplicative->startingPosition;
+	CompileFactor(multiplicative->factors.front().get());
+	for (size_t i = 0; i < multiplicative->operators.size(); ++i)
+	{
+		CompileFactor(multiplicative->factors[i + 1].get());
+		switch (multiplicative->operators[i])
+		{
+		case MultiplicationOperator::Multiply:
+			Emit(OpCode::Multiply);
+			break;
+		case MultiplicationOperator::Divide:
+			Emit(OpCode::Divide);
+			break;
+		default:
+			throw CompilerException("Cannot handle such operator.", currentPosition);
+			break;
+		}
+	}
+}
+
+void BytecodeCompiler::CompileFactor(const Factor* const factor)
+{
+	currentPosition = factor->startingPosition;
+	if (auto identifier = std::get_if<Symbol>(&factor->factor))
+	{
+		// Negation of variable is not applied, same as in Interpreter::EvaluateFactor
+		const auto local = FindLocal(*identifier);
+		if (!local)
+		{
+			std::stringstream ss;
+			ss << "Variable '" << StringConversion::ToNarrow(identifier->GetName()) << "' was not declared.";
+			Emit(OpCode::Throw, AddMessage(ss.str()));
+			return;
+		}
+		if (!local->initialized)
+		{
+			std::stringstream ss;
+			ss << "Variable '" << StringConversion::ToNarrow(identifier->GetName()) << "' does not have value.";
+			Emit(OpCode::Throw, AddMessage(ss.str()));
+			return;
+		}
+		Emit(OpCode::LoadLocal, local->slot);
+		return;
+	}
+	if (auto literal = std::get_if<Literal>(&factor->factor))
+	{
+		CompileLiteral(*literal);
+	}
+	else if (auto stdExpr = std::get_if<std::unique_ptr<StandardExpression>>(&factor->factor))
+	{
+		CompileStandardExpression(stdExpr->get());
+	}
+	else if (auto funcCall = std::get_if<std::unique_ptr<FunctionCall>>(&factor->factor))
+	{
+		CompileFunctionCall(funcCall->get(), true);
+		Emit(OpCode::PushReturnValue);
+	}
+	if (factor->logicallyNegated)
+	{
+		Emit(OpCode::Not);
+	}
+}
+
+void BytecodeCompiler::CompileLiteral(const Literal& literal)
+{
+	currentPosition = literal.startingPosition;
+	Value value;
+	if (std::holds_alternative<int>(literal.value))
+	{
+		value = Value(std::get<int>(literal.value));
+	}
+	else if (std::holds_alternative<bool>(literal.value))
+	{
+		value = Value(std::get<bool>(literal.value));
+	}
+	else if (std::holds_alternative<std::wstring>(literal.value))
+	{
+		value = Value(stringPool.Intern(std::get<std::wstring>(literal.value)));
+	}
+	else if (std::holds_alternative<float>(literal.value))
+	{
+		value = Value(std::get<float>(literal.value));
+	}
+	module.constants.push_back(std::move(value));
+	Emit(OpCode::PushConstant, static_cast<uint32_t>(module.constants.size() - 1));
+}
+
+void BytecodeCompiler::CompileFuncExpression(const FuncExpression* const funcExpression)
+{
+	currentPosition = funcExpression->startingPosition;
+	for (size_t i = 0; i < funcExpression->composables.size(); ++i)
+	{
+		CompileComposable(funcExpression->composables[i].get());
+		if (i > 0)
+		{
+			Emit(OpCode::Compose);
+		}
+	}
+}
+
+void BytecodeCompiler::CompileComposable(const Composable* const composable)
+{
+	currentPosition = composable->startingPosition;
+	CompileBindable(composable->bindable.get());
+	if (!composable->arguments.empty())
+	{
+		CompileArguments(composable->arguments);
+		Emit(OpCode::Bind, static_cast<uint32_t>(composable->arguments.size()));
+	}
+}
+
+void BytecodeCompiler::CompileBindable(const Bindable* const bindable)
+{
+	currentPosition = bindable->startingPosition;
+	if (auto funcLit = std::get_if<std::unique_ptr<FunctionLiteral>>(&bindable->bindable))
+	{
+		const auto& functionLiteral = *funcLit;
+		if (!functionLiteral->block)
+		{
+			Emit(OpCode::Throw, AddMessage("Function literal does not have block."));
+			return;
+		}
+		const auto chunkIndex = AddChunk(Symbol(), functionLiteral->block.get(), functionLiteral->parameters, functionLiteral->startingPosition);
+		Emit(OpCode::MakeFunction, static_cast<uint32_t>(chunkIndex));
+	}
+	else if (auto funcExpr = std::get_if<std::unique_ptr<FuncExpression>>(&bindable->bindable))
+	{
+		CompileFuncExpression(funcExpr->get());
+	}
+	else if (auto funcCall = std::get_if<std::unique_ptr<FunctionCall>>(&bindable->bindable))
+	{
+		CompileFunctionCall(funcCall->get(), true);
+		Emit(OpCode::PushReturnValue);
+	}
+	else if (auto identifier = std::get_if<Symbol>(&bindable->bindable))
+	{
+		if (const auto local = FindLocal(*identifier))
+		{
+			if (!local->initialized)
+			{
+				Emit(OpCode::Throw, AddMessage("Variable does not have value."));
+				return;
+			}
+			Emit(OpCode::LoadLocalBindable, local->slot);
+		}
+		else if (const auto functionIndex = FindFunction(*identifier))
+		{
+			Emit(OpCode::LoadFunction, *functionIndex);
+		}
+		else
+		{
+			Emit(OpCode::Throw, AddMessage("Variable nor function with such name was not declared."));
+		}
+	}
+}
+
+void BytecodeCompiler::CompileArguments(const std::vector<std::unique_ptr<Expression>>& arguments)
+{
+	for (const auto& argument : arguments)
+	{
+		CompileExpression(argument.get());
+	}
+}
+
+size_t BytecodeCompiler::Emit(const OpCode opCode, const uint32_t operand)
+{
+	auto& chunk = module.chunks[currentChunk];
+	chunk.code.push_back({ opCode, operand });
+	chunk.positions.push_back(currentPosition);
+	return chunk.code.size() - 1;
+}
+
+void BytecodeCompiler::PatchJump(const size_t instructionIndex)
+{
+	auto& chunk = module.chunks[currentChunk];
+	chunk.code[instructionIndex].operand = static_cast<uint32_t>(chunk.code.size());
+}
+
+uint32_t BytecodeCompiler::AddMessage(const std::string& message)
+{
+	module.messages.push_back(message);
+	return static_cast<uint32_t>(module.messages.size() - 1);
+}
+
+uint32_t BytecodeCompiler::DeclareLocal(const Symbol identifier, const bool isMutable, const bool initialized)
+{
+	auto& chunk = module.chunks[currentChunk];
+	const auto slot = static_cast<uint32_t>(chunk.slotNames.size());
+	chunk.slotNames.push_back(identifier);
+	scopes.back().emplace(identifier, LocalVariable{ slot, isMutable, initialized });
+	return slot;
+}
+
+BytecodeCompiler::LocalVariable* BytecodeCompiler::FindLocal(const Symbol identifier)
+{
+	for (auto scope = scopes.rbegin(); scope != scopes.rend(); ++scope)
+	{
+		if (const auto it = scope->find(identifier); it != scope->end())
+		{
+			return &it->second;
+		}
+	}
+	return nullptr;
+}
+
+std::optional<uint32_t> BytecodeCompiler::FindFunction(const Symbol identifier) const
+{
+	if (const auto it = functionIndices.find(identifier); it != functionIndices.end())
+	{
+		return it->second;
+	}
+	return std::nullopt;
+}
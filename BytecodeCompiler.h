@@ -0,0 +1,74 @@
+#pragma once
+#include "Bytecode.h"
+#include "ParserObjects/ParserObjects.h"
+#include "StringPool.h"
+#include <unordered_map>
+
+// Lowers Program into BytecodeModule executed by VirtualMachine, keeping semantics of the Interpreter.
+class BytecodeCompiler
+{
+public:
+	class CompilerException : public InterpreterException
+	{
+	public:
+		CompilerException(const char* msg, const Position pos)
+			: InterpreterException(msg, pos)
+		{
+		}
+	};
+
+	BytecodeModule Compile(const Program* const program);
+
+private:
+	struct LocalVariable
+	{
+		uint32_t slot;
+		bool isMutable;
+		bool initialized;
+	};
+	using CompilerScope = std::unordered_map<Symbol, LocalVariable>;
+
+	size_t AddChunk(const Symbol name, Block* const block, const std::vector<Param>& parameters, const Position position);
+	void CompileChunk(const size_t chunkIndex);
+
+	void CompileBlock(const Block* const block);
+	void CompileStatement(const Statement* const statement);
+	void CompileFunctionCallStatement(const FunctionCallStatement* const functionCallStatement);
+	void CompileWhileLoop(const WhileLoop* const whileLoop);
+	void CompileReturn(const Return* const returnStatement);
+	void CompileConditional(const Conditional* const conditional);
+	void CompileDeclaration(const Declaration* const declaration);
+	void CompileAssignment(const Assignment* const assignment);
+	void CompileFunctionCall(const FunctionCall* const functionCall, const bool valueExpected);
+
+	void CompileExpression(const Expression* const expression);
+	void CompileStandardExpression(const StandardExpression* const expression);
+	void CompileConjunction(const Conjunction* const conjunction);
+	void CompileRelation(const Relation* const relation);
+	void CompileAdditive(const Additive* const additive);
+	void CompileMultiplicative(const Multiplicative* const multiplicative);
+	void CompileFactor(const Factor* const factor);
+	void CompileLiteral(const Literal& literal);
+
+	void CompileFuncExpression(const FuncExpression* const funcExpression);
+	void CompileComposable(const Composable* const composable);
+	void CompileBindable(const Bindable* const bindable);
+	void CompileArguments(const std::vector<std::unique_ptr<Expression>>& arguments);
+
+	size_t Emit(const OpCode opCode, const uint32_t operand = 0);
+	void PatchJump(const size_t instructionIndex);
+	uint32_t AddMessage(const std::string& message);
+	uint32_t DeclareLocal(const Symbol identifier, const bool isMutable, const bool initialized);
+	LocalVariable* FindLocal(const Symbol identifier);
+	std::optional<uint32_t> FindFunction(const Symbol identifier) const;
+
+private:
+	BytecodeModule module;
+	size_t currentChunk = 0;
+	std::vector<size_t> pendingChunks;
+	std::vector<CompilerScope> scopes;
+	std::vector<std::vector<size_t>> pendingBlockExits;
+	std::unordered_map<Symbol, uint32_t> functionIndices;
+	StringPool stringPool;
+	Position currentPosition = Position(0, 0);
+};
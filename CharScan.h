@@ -0,0 +1,189 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CHAR_SCAN_VECTORS 32
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CHAR_SCAN_VECTORS 16
+#endif
+
+// Scanning of character runs the Lexer skips or copies without looking at single characters.
+// Works on UTF-8 bytes (char) and wchar_t, whole vectors are compared at once when SSE2 or AVX2 is available
+// (AVX2 only when compiled for it, see INTERPRETER_AVX2), the tail and other targets use the scalar loop.
+namespace CharScan
+{
+	namespace Detail
+	{
+#if CHAR_SCAN_VECTORS == 32
+		using Vector = __m256i;
+
+		inline Vector Load(const void* const address) noexcept { return _mm256_loadu_si256(static_cast<const __m256i*>(address)); }
+		inline Vector Or(const Vector a, const Vector b) noexcept { return _mm256_or_si256(a, b); }
+		inline Vector And(const Vector a, const Vector b) noexcept { return _mm256_and_si256(a, b); }
+		inline uint32_t ByteMask(const Vector vector) noexcept { return static_cast<uint32_t>(_mm256_movemask_epi8(vector)); }
+
+		template<typename Char>
+		Vector Splat(const int value) noexcept
+		{
+			if constexpr (sizeof(Char) == 1) { return _mm256_set1_epi8(static_cast<char>(value)); }
+			else if constexpr (sizeof(Char) == 2) { return _mm256_set1_epi16(static_cast<short>(value)); }
+			else { return _mm256_set1_epi32(value); }
+		}
+
+		template<typename Char>
+		Vector Equal(const Vector a, const Vector b) noexcept
+		{
+			if constexpr (sizeof(Char) == 1) { return _mm256_cmpeq_epi8(a, b); }
+			else if constexpr (sizeof(Char) == 2) { return _mm256_cmpeq_epi16(a, b); }
+			else { return _mm256_cmpeq_epi32(a, b); }
+		}
+
+		// Signed compare, characters with the highest bit set count as negative
+		template<typename Char>
+		Vector Greater(const Vector a, const Vector b) noexcept
+		{
+			if constexpr (sizeof(Char) == 1) { return _mm256_cmpgt_epi8(a, b); }
+			else if constexpr (sizeof(Char) == 2) { return _mm256_cmpgt_epi16(a, b); }
+			else { return _mm256_cmpgt_epi32(a, b); }
+		}
+#elif CHAR_SCAN_VECTORS == 16
+		using Vector = __m128i;
+
+		inline Vector Load(const void* const address) noexcept { return _mm_loadu_si128(static_cast<const __m128i*>(address)); }
+		inline Vector Or(const Vector a, const Vector b) noexcept { return _mm_or_si128(a, b); }
+		inline Vector And(const Vector a, const Vector b) noexcept { return _mm_and_si128(a, b); }
+		inline uint32_t ByteMask(const Vector vector) noexcept { return static_cast<uint32_t>(_mm_movemask_epi8(vector)); }
+
+		template<typename Char>
+		Vector Splat(const int value) noexcept
+		{
+			if constexpr (sizeof(Char) == 1) { return _mm_set1_epi8(static_cast<char>(value)); }
+			else if constexpr (sizeof(Char) == 2) { return _mm_set1_epi16(static_cast<short>(value)); }
+			else { return _mm_set1_epi32(value); }
+		}
+
+		template<typename Char>
+		Vector Equal(const Vector a, const Vector b) noexcept
+		{
+			if constexpr (sizeof(Char) == 1) { return _mm_cmpeq_epi8(a, b); }
+			else if constexpr (sizeof(Char) == 2) { return _mm_cmpeq_epi16(a, b); }
+			else { return _mm_cmpeq_epi32(a, b); }
+		}
+
+		// Signed compare, characters with the highest bit set count as negative
+		template<typename Char>
+		Vector Greater(const Vector a, const Vector b) noexcept
+		{
+			if constexpr (sizeof(Char) == 1) { return _mm_cmpgt_epi8(a, b); }
+			else if constexpr (sizeof(Char) == 2) { return _mm_cmpgt_epi16(a, b); }
+			else { return _mm_cmpgt_epi32(a, b); }
+		}
+#endif
+
+		// Returns first character for which the vector mask (one bit per byte) or the scalar predicate matches
+		template<typename Char, typename VectorMatch, typename ScalarMatch>
+		const Char* FindFirst(const Char* begin, const Char* const end, const VectorMatch& vectorMatch, const ScalarMatch& scalarMatch) noexcept
+		{
+#ifdef CHAR_SCAN_VECTORS
+			constexpr std::ptrdiff_t charsPerVector = CHAR_SCAN_VECTORS / sizeof(Char);
+			while (end - begin >= charsPerVector)
+			{
+				const uint32_t mask = vectorMatch(Load(begin));
+				if (mask != 0)
+				{
+					return begin + std::countr_zero(mask) / sizeof(Char);
+				}
+				begin += charsPerVector;
+			}
+#endif
+			while (begin != end && !scalarMatch(*begin))
+			{
+				++begin;
+			}
+			return begin;
+		}
+
+		// Same set as std::isspace in the "C" locale
+		template<typename Char>
+		constexpr bool IsWhitespace(const Char character) noexcept
+		{
+			return character == Char(' ') || (character >= Char('\t') && character <= Char('\r'));
+		}
+	}
+
+	// First character that is not whitespace
+	template<typename Char>
+	const Char* SkipWhitespace(const Char* const begin, const Char* const end) noexcept
+	{
+		return Detail::FindFirst(begin, end,
+#ifdef CHAR_SCAN_VECTORS
+			[](const Detail::Vector characters)
+			{
+				using namespace Detail;
+				const auto whitespace = Or(Equal<Char>(characters, Splat<Char>(' ')),
+					And(Greater<Char>(characters, Splat<Char>('\t' - 1)), Greater<Char>(Splat<Char>('\r' + 1), characters)));
+				constexpr uint32_t allBytes = CHAR_SCAN_VECTORS == 32 ? 0xFFFFFFFFu : 0xFFFFu;
+				return ~ByteMask(whitespace) & allBytes;
+			},
+#else
+			nullptr,
+#endif
+			[](const Char character) { return !Detail::IsWhitespace(character); });
+	}
+
+	// First occurrence of delimiter
+	template<typename Char>
+	const Char* Find(const Char* const begin, const Char* const end, const Char delimiter) noexcept
+	{
+		return Detail::FindFirst(begin, end,
+#ifdef CHAR_SCAN_VECTORS
+			[delimiter](const Detail::Vector characters)
+			{
+				using namespace Detail;
+				return ByteMask(Equal<Char>(characters, Splat<Char>(static_cast<int>(delimiter))));
+			},
+#else
+			nullptr,
+#endif
+			[delimiter](const Char character) { return character == delimiter; });
+	}
+
+	// First character ending a plain run of string literal text: quote, backslash or (for UTF-8) non-ASCII byte
+	template<typename Char>
+	const Char* FindStringLiteralStop(const Char* const begin, const Char* const end) noexcept
+	{
+		return Detail::FindFirst(begin, end,
+#ifdef CHAR_SCAN_VECTORS
+			[](const Detail::Vector characters)
+			{
+				using namespace Detail;
+				const auto stops = ByteMask(Or(Equal<Char>(characters, Splat<Char>('"')), Equal<Char>(characters, Splat<Char>('\\'))));
+				if constexpr (sizeof(Char) == 1)
+				{
+					return stops | ByteMask(characters);
+				}
+				else
+				{
+					return stops;
+				}
+			},
+#else
+			nullptr,
+#endif
+			[](const Char character)
+			{
+				if constexpr (sizeof(Char) == 1)
+				{
+					if (static_cast<unsigned char>(character) >= 0x80)
+					{
+						return true;
+					}
+				}
+				return character == Char('"') || character == Char('\\');
+			});
+	}
+}
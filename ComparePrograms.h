@@ -55,7 +55,7 @@ static void CompareStandardExpressions(const StandardExpression* const expressio
 
 static void CompareFunctionCalls(const FunctionCall* const funcCall, const FunctionCall* const expectedFuncCall)
 {
-	EXPECT_EQ(funcCall->identifier, expectedFuncCall->identifier);
+	EXPECT_EQ(funcCall->identifier.GetName(), expectedFuncCall->identifier.GetName());
 	ASSERT_EQ(funcCall->arguments.size(), expectedFuncCall->arguments.size());
 
 	for (size_t i = 0; i < funcCall->arguments.size(); ++i)
@@ -108,11 +108,11 @@ static void CompareBindables(const Bindable* const bindable, const Bindable* con
 		ASSERT_TRUE(expectedFuncCall != nullptr);
 		CompareFunctionCalls(funcCall->get(), expectedFuncCall->get());
 	}
-	else if (auto* str = std::get_if<std::wstring>(&bindable->bindable))
+	else if (auto* str = std::get_if<Symbol>(&bindable->bindable))
 	{
-		auto* expectedStr = std::get_if<std::wstring>(&expectedBindable->bindable);
+		auto* expectedStr = std::get_if<Symbol>(&expectedBindable->bindable);
 		ASSERT_TRUE(expectedStr != nullptr);
-		EXPECT_EQ(*str, *expectedStr);
+		EXPECT_EQ(str->GetName(), expectedStr->GetName());
 	}
 }
 
@@ -188,11 +188,11 @@ static void CompareFactors(const Factor* const factor, const Factor* const expec
 		ASSERT_TRUE(expectedFuncCall != nullptr);
 		CompareFunctionCalls(funcCall->get(), expectedFuncCall->get());
 	}
-	else if (auto* str = std::get_if<std::wstring>(&factor->factor))
+	else if (auto* str = std::get_if<Symbol>(&factor->factor))
 	{
-		auto* expectedStr = std::get_if<std::wstring>(&expectedFactor->factor);
+		auto* expectedStr = std::get_if<Symbol>(&expectedFactor->factor);
 		ASSERT_TRUE(expectedStr != nullptr);
-		EXPECT_EQ(*str, *expectedStr);
+		EXPECT_EQ(str->GetName(), expectedStr->GetName());
 	}
 }
 
@@ -228,20 +228,23 @@ static void CompareReturns(const Return* const returnStmt, const Return* const e
 static void CompareDeclarations(const Declaration* const declaration, const Declaration* const expectedDeclaration)
 {
 	EXPECT_EQ(declaration->varMutable, expectedDeclaration->varMutable);
-	EXPECT_EQ(declaration->identifier, expectedDeclaration->identifier);
-	CompareExpressions(declaration->expression.get(), expectedDeclaration->expression.get());
+	EXPECT_EQ(declaration->identifier.GetName(), expectedDeclaration->identifier.GetName());
+	if (declaration->expression != expectedDeclaration->expression)
+	{
+		CompareExpressions(declaration->expression.get(), expectedDeclaration->expression.get());
+	}
 }
 
 static void CompareAssignments(const Assignment* const assignment, const Assignment* const expectedAssignment)
 {
-	EXPECT_EQ(assignment->identifier, expectedAssignment->identifier);
+	EXPECT_EQ(assignment->identifier.GetName(), expectedAssignment->identifier.GetName());
 	CompareExpressions(assignment->expression.get(), expectedAssignment->expression.get());
 }
 
 static void CompareParams(const Param& param, const Param& expectedParam)
 {
 	EXPECT_EQ(param.paramMutable, expectedParam.paramMutable);
-	EXPECT_EQ(param.identifier, expectedParam.identifier);
+	EXPECT_EQ(param.identifier.GetName(), expectedParam.identifier.GetName());
 }
 
 static void CompareBlocks(const Block* const block, const Block* const expectedBlock)
@@ -306,7 +309,7 @@ static void CompareStatements(const Statement* const statement, const Statement*
 
 static void CompareFunDefs(const FunctionDefiniton* const funDef, const FunctionDefiniton* const expectedFunDef)
 {
-	EXPECT_EQ(funDef->identifier, expectedFunDef->identifier);
+	EXPECT_EQ(funDef->identifier.GetName(), expectedFunDef->identifier.GetName());
 	ASSERT_EQ(funDef->parameters.size(), expectedFunDef->parameters.size());
 
 	for (size_t i = 0; i < funDef->parameters.size(); ++i)
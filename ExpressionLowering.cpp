@@ -0,0 +1,244 @@
+#include "ExpressionLowering.h"
+
+namespace
+{
+	using Kind = ExpressionNode::Kind;
+
+	Kind ToKind(const RelationOperator relationOperator) noexcept
+	{
+		switch (relationOperator)
+		{
+		case RelationOperator::Equal:
+			return Kind::Equal;
+		case RelationOperator::NotEqual:
+			return Kind::NotEqual;
+		case RelationOperator::Greater:
+			return Kind::Greater;
+		case RelationOperator::GreaterEqual:
+			return Kind::GreaterEqual;
+		case RelationOperator::Less:
+			return Kind::Less;
+		default:
+			return Kind::LessEqual;
+		}
+	}
+}
+
+void ExpressionLowering::Lower(Program* const program)
+{
+	for (const auto& funDef : program->funDefs)
+	{
+		LowerBlock(funDef->block.get());
+	}
+}
+
+void ExpressionLowering::LowerBlock(Block* const block)
+{
+	if (!block)
+	{
+		return;
+	}
+	for (const auto& statement : block->statements)
+	{
+		LowerStatement(statement.get());
+	}
+}
+
+void ExpressionLowering::LowerStatement(Statement* const statement)
+{
+	if (auto block = dynamic_cast<Block*>(statement))
+	{
+		LowerBlock(block);
+	}
+	else if (auto functionCallStatement = dynamic_cast<FunctionCallStatement*>(statement))
+	{
+		LowerFunctionCall(functionCallStatement->funcCall.get());
+	}
+	else if (auto whileLoop = dynamic_cast<WhileLoop*>(statement))
+	{
+		LowerStandardExpression(whileLoop->condition.get());
+		LowerBlock(whileLoop->block.get());
+	}
+	else if (auto returnStatement = dynamic_cast<Return*>(statement))
+	{
+		LowerExpression(returnStatement->expression.get());
+	}
+	else if (auto conditional = dynamic_cast<Conditional*>(statement))
+	{
+		LowerStandardExpression(conditional->condition.get());
+		LowerBlock(conditional->ifBlock.get());
+		LowerBlock(conditional->elseBlock.get());
+	}
+	else if (auto declaration = dynamic_cast<Declaration*>(statement))
+	{
+		LowerExpression(declaration->expression.get());
+	}
+	else if (auto assignment = dynamic_cast<Assignment*>(statement))
+	{
+		LowerExpression(assignment->expression.get());
+	}
+}
+
+void ExpressionLowering::LowerFunctionCall(FunctionCall* const functionCall)
+{
+	if (!functionCall)
+	{
+		return;
+	}
+	for (const auto& arg : functionCall->arguments)
+	{
+		LowerExpression(arg.get());
+	}
+}
+
+void ExpressionLowering::LowerExpression(Expression* const expression)
+{
+	if (auto standardExpression = dynamic_cast<StandardExpression*>(expression))
+	{
+		LowerStandardExpression(standardExpression);
+	}
+	else if (auto funcExpression = dynamic_cast<FuncExpression*>(expression))
+	{
+		LowerFuncExpression(funcExpression);
+	}
+}
+
+void ExpressionLowering::LowerStandardExpression(StandardExpression* const expression)
+{
+	if (!expression)
+	{
+		return;
+	}
+	// Expressions are never nested in the array being built, function call arguments are lowered on their own afterwards
+	std::vector<ExpressionNode> lowered;
+	nodes = &lowered;
+	AddNodes(expression);
+	nodes = nullptr;
+	expression->lowered = std::move(lowered);
+
+	for (const auto& node : expression->lowered)
+	{
+		if (!node.factor)
+		{
+			continue;
+		}
+		if (auto funcCall = std::get_if<std::unique_ptr<FunctionCall>>(&node.factor->factor))
+		{
+			LowerFunctionCall(funcCall->get());
+		}
+	}
+}
+
+void ExpressionLowering::LowerFuncExpression(FuncExpression* const funcExpression)
+{
+	for (const auto& composable : funcExpression->composables)
+	{
+		LowerBindable(composable->bindable.get());
+		for (const auto& arg : composable->arguments)
+		{
+			LowerExpression(arg.get());
+		}
+	}
+}
+
+void ExpressionLowering::LowerBindable(Bindable* const bindable)
+{
+	if (!bindable)
+	{
+		return;
+	}
+	if (auto funcLit = std::get_if<std::unique_ptr<FunctionLiteral>>(&bindable->bindable))
+	{
+		LowerBlock((*funcLit)->block.get());
+	}
+	else if (auto funcExpr = std::get_if<std::unique_ptr<FuncExpression>>(&bindable->bindable))
+	{
+		LowerFuncExpression(funcExpr->get());
+	}
+	else if (auto funcCall = std::get_if<std::unique_ptr<FunctionCall>>(&bindable->bindable))
+	{
+		LowerFunctionCall(funcCall->get());
+	}
+}
+
+uint32_t ExpressionLowering::AddNodes(StandardExpression* const expression)
+{
+	// Alternatives and conjunctions short circuit the same way as the whole chain does in the cascade
+	auto root = AddNodes(expression->conjunctions.front().get());
+	for (size_t i = 1; i < expression->conjunctions.size(); ++i)
+	{
+		const auto right = AddNodes(expression->conjunctions[i].get());
+		root = AddNode({ Kind::Or, root, right });
+	}
+	return root;
+}
+
+uint32_t ExpressionLowering::AddNodes(Conjunction* const conjunction)
+{
+	auto root = AddNodes(conjunction->relations.front().get());
+	for (size_t i = 1; i < conjunction->relations.size(); ++i)
+	{
+		const auto right = AddNodes(conjunction->relations[i].get());
+		root = AddNode({ Kind::And, root, right });
+	}
+	return root;
+}
+
+uint32_t ExpressionLowering::AddNodes(Relation* const relation)
+{
+	const auto first = AddNodes(relation->firstAdditive.get());
+	if (!relation->relationOperator)
+	{
+		return first;
+	}
+	const auto second = AddNodes(relation->secondAdditive.get());
+	return AddNode({ ToKind(*relation->relationOperator), first, second });
+}
+
+uint32_t ExpressionLowering::AddNodes(Additive* const additive)
+{
+	auto root = AddNodes(additive->multiplicatives.front().get());
+	for (size_t i = 0; i < additive->operators.size(); ++i)
+	{
+		const auto right = AddNodes(additive->multiplicatives[i + 1].get());
+		root = AddNode({ additive->operators[i] == AdditionOperator::Plus ? Kind::Add : Kind::Subtract, root, right });
+	}
+	return additive->negated ? AddNode({ Kind::Negate, root }) : root;
+}
+
+uint32_t ExpressionLowering::AddNodes(Multiplicative* const multiplicative)
+{
+	auto root = AddNodes(multiplicative->factors.front().get());
+	for (size_t i = 0; i < multiplicative->operators.size(); ++i)
+	{
+		const auto right = AddNodes(multiplicative->factors[i + 1].get());
+		root = AddNode({ multiplicative->operators[i] == MultiplicationOperator::Multiply ? Kind::Multiply : Kind::Divide, root, right });
+	}
+	return root;
+}
+
+uint32_t ExpressionLowering::AddNodes(Factor* const factor)
+{
+	if (auto stdExpr = std::get_if<std::unique_ptr<StandardExpression>>(&factor->factor))
+	{
+		const auto root = AddNodes(stdExpr->get());
+		return factor->logicallyNegated ? AddNode({ Kind::LogicalNot, root }) : root;
+	}
+	auto literal = std::get_if<Literal>(&factor->factor);
+	if (literal && std::holds_alternative<std::wstring>(literal->value))
+	{
+		literal->interned = literalStrings.Intern(std::get<std::wstring>(literal->value));
+	}
+	if (literal && !factor->logicallyNegated)
+	{
+		return AddNode({ Kind::Literal, 0, 0, literal });
+	}
+	// Variables and function calls are evaluated by the factor itself
+	return AddNode({ Kind::Factor, 0, 0, nullptr, factor });
+}
+
+uint32_t ExpressionLowering::AddNode(const ExpressionNode& node)
+{
+	nodes->push_back(node);
+	return static_cast<uint32_t>(nodes->size() - 1);
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include "ParserObjects/ParserObjects.h"
+#include "StringPool.h"
+
+// Lowers every StandardExpression evaluated on its own (statement conditions and values, function arguments)
+// into ExpressionNode array, so the Interpreter does not walk all levels of the precedence cascade.
+// Parenthesized expressions are lowered into the array of the expression containing them. Cascade is left intact.
+// String literals met on the way are interned, so evaluating them neither allocates nor hashes.
+class ExpressionLowering
+{
+public:
+	void Lower(Program* const program);
+
+private:
+	void LowerBlock(Block* const block);
+	void LowerStatement(Statement* const statement);
+	void LowerFunctionCall(FunctionCall* const functionCall);
+	void LowerExpression(Expression* const expression);
+	void LowerStandardExpression(StandardExpression* const expression);
+	void LowerFuncExpression(FuncExpression* const funcExpression);
+	void LowerBindable(Bindable* const bindable);
+
+	uint32_t AddNodes(StandardExpression* const expression);
+	uint32_t AddNodes(Conjunction* const conjunction);
+	uint32_t AddNodes(Relation* const relation);
+	uint32_t AddNodes(Additive* const additive);
+	uint32_t AddNodes(Multiplicative* const multiplicative);
+	uint32_t AddNodes(Factor* const factor);
+	uint32_t AddNode(const ExpressionNode& node);
+
+	std::vector<ExpressionNode>* nodes = nullptr;
+	StringPool literalStrings;
+};
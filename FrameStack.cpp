@@ -0,0 +1,122 @@
+#include "FrameStack.h"
+
+void FrameStack::PushFunctionFrame(const bool valueExpectedInCurrentFunction)
+{
+	PushFrame({ variablesCount, frames.size(), valueExpectedInCurrentFunction });
+}
+
+void FrameStack::PushBlockFrame()
+{
+	const auto& higherFrame = frames.back();
+	PushFrame({ variablesCount, higherFrame.functionFrame, higherFrame.valueExpectedInCurrentFunction });
+}
+
+void FrameStack::PushFrame(const Frame& frame)
+{
+	if (frames.size() == frames.capacity())
+	{
+		++heapAllocationsCount;
+	}
+	frames.push_back(frame);
+}
+
+void FrameStack::PopFrame() noexcept
+{
+	const auto firstVariable = frames.back().firstVariable;
+	for (size_t i = firstVariable; i < variablesCount; ++i)
+	{
+		VariableAt(i).value = std::nullopt;
+	}
+	variablesCount = firstVariable;
+	frames.pop_back();
+}
+
+void FrameStack::Clear() noexcept
+{
+	while (!frames.empty())
+	{
+		PopFrame();
+	}
+	variablesCount = 0;
+}
+
+FrameStack::Variable& FrameStack::PushVariable(const bool isMutable, const Symbol identifier, std::optional<Value> value)
+{
+	if (variablesCount == blocks.size() * variablesPerBlock)
+	{
+		blocks.push_back(std::make_unique<Variable[]>(variablesPerBlock));
+		++heapAllocationsCount;
+	}
+	auto& variable = VariableAt(variablesCount++);
+	variable.isMutable = isMutable;
+	variable.identifier = identifier;
+	variable.value = std::move(value);
+	return variable;
+}
+
+FrameStack::Variable* FrameStack::GetVariable(const Symbol identifier) noexcept
+{
+	if (frames.empty())
+	{
+		return nullptr;
+	}
+	const auto functionFrame = frames.back().functionFrame;
+	for (size_t frameIndex = frames.size(); frameIndex-- > functionFrame;)
+	{
+		const auto frameEnd = FrameEnd(frameIndex);
+		for (size_t i = frames[frameIndex].firstVariable; i < frameEnd; ++i)
+		{
+			auto& variable = VariableAt(i);
+			if (variable.identifier == identifier)
+			{
+				return &variable;
+			}
+		}
+	}
+	return nullptr;
+}
+
+FrameStack::Variable* FrameStack::GetVariable(const VariableSlot& variableSlot) noexcept
+{
+	if (frames.empty() || variableSlot.depth > frames.size() - 1 - frames.back().functionFrame)
+	{
+		return nullptr;
+	}
+	const auto frameIndex = frames.size() - 1 - variableSlot.depth;
+	const auto index = frames[frameIndex].firstVariable + variableSlot.slot;
+	if (index >= FrameEnd(frameIndex))
+	{
+		return nullptr;
+	}
+	return &VariableAt(index);
+}
+
+bool FrameStack::VariableAlreadyExists(const Symbol identifier) noexcept
+{
+	return GetVariable(identifier) != nullptr;
+}
+
+bool FrameStack::ValueExpectedInCurrentFunction() const noexcept
+{
+	return frames.back().valueExpectedInCurrentFunction;
+}
+
+size_t FrameStack::GetHeapAllocationsCount() const noexcept
+{
+	return heapAllocationsCount;
+}
+
+void FrameStack::ResetHeapAllocationsCount() noexcept
+{
+	heapAllocationsCount = 0;
+}
+
+FrameStack::Variable& FrameStack::VariableAt(const size_t index) noexcept
+{
+	return blocks[index / variablesPerBlock][index % variablesPerBlock];
+}
+
+size_t FrameStack::FrameEnd(const size_t frameIndex) const noexcept
+{
+	return (frameIndex + 1 < frames.size()) ? frames[frameIndex + 1].firstVariable : variablesCount;
+}
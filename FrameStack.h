@@ -0,0 +1,57 @@
+#pragma once
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "Value.h"
+#include "ParserObjects/Expressions.h"
+
+// Stack of scopes used by the Interpreter.
+// Variables are bump allocated in fixed size blocks which are kept after being popped,
+// so once the deepest frame was reached entering and leaving scopes does not allocate.
+class FrameStack
+{
+public:
+	struct Variable
+	{
+		Variable() = default;
+		Variable(const bool isMutable, const Symbol identifier, std::optional<Value> value = std::nullopt) noexcept :
+			isMutable(isMutable), identifier(identifier), value(value) {
+		}
+		bool isMutable = false;
+		Symbol identifier;
+		std::optional<Value> value = std::nullopt;
+	};
+
+	void PushFunctionFrame(const bool valueExpectedInCurrentFunction);
+	void PushBlockFrame();
+	void PopFrame() noexcept;
+	void Clear() noexcept;
+
+	Variable& PushVariable(const bool isMutable, const Symbol identifier, std::optional<Value> value = std::nullopt);
+	Variable* GetVariable(const Symbol identifier) noexcept;
+	Variable* GetVariable(const VariableSlot& variableSlot) noexcept;
+	bool VariableAlreadyExists(const Symbol identifier) noexcept;
+	bool ValueExpectedInCurrentFunction() const noexcept;
+
+	size_t GetHeapAllocationsCount() const noexcept;
+	void ResetHeapAllocationsCount() noexcept;
+
+private:
+	struct Frame
+	{
+		size_t firstVariable;
+		size_t functionFrame;
+		bool valueExpectedInCurrentFunction;
+	};
+
+	void PushFrame(const Frame& frame);
+	Variable& VariableAt(const size_t index) noexcept;
+	size_t FrameEnd(const size_t frameIndex) const noexcept;
+
+	static constexpr size_t variablesPerBlock = 64;
+	std::vector<std::unique_ptr<Variable[]>> blocks;
+	std::vector<Frame> frames;
+	size_t variablesCount = 0;
+	size_t heapAllocationsCount = 0;
+};
@@ -6,22 +6,21 @@
 void Interpreter::Interpret(const Program* const program)
 {
 	currentPosition = { 0, 0 };
+	knownFunctions.clear();
+	frameStack.Clear();
+	frameStack.ResetHeapAllocationsCount();
 	try
 	{
-		const FunctionDefiniton* mainFunction = nullptr;
 		for (const auto& funDef : program->funDefs)
 		{
-			if (funDef->identifier == L"Main")
-			{
-				mainFunction = funDef.get();
-			}
-			knownFunctions.push_back(funDef.get());
+			knownFunctions.emplace(funDef->identifier, funDef.get());
 		}
+		const auto mainFunction = GetFunction(L"Main");
 		if (mainFunction)
 		{
-			currentScope = std::make_shared<Scope>();
-			currentScope->valueExpectedInCurrentFunction = true;
+			frameStack.PushFunctionFrame(true);
 			InterpretFunDef(mainFunction);
+			frameStack.PopFrame();
 		}
 		else
 		{
@@ -41,12 +40,7 @@ void Interpreter::Interpret(const Program* const program)
 void Interpreter::InterpretFunDef(const FunctionDefiniton* const funDef, const std::vector<Value>& arguments)
 {
 	currentPosition = funDef->startingPosition;
-	std::wstring argumentsString;
-	for (const auto& arg : arguments)
-	{
-		argumentsString += arg.ToPrintString() + L" ";
-	}
-	Print(L"Function: " + funDef->identifier + L" Arguments: " + argumentsString);
+	Trace(TraceEventType::FunctionEntry, funDef->identifier, arguments);
 	if (funDef->parameters.size() != arguments.size())
 	{
 		std::stringstream ss;
@@ -55,7 +49,7 @@ void Interpreter::InterpretFunDef(const FunctionDefiniton* const funDef, const s
 	}
 	for (size_t i = 0; i < arguments.size(); ++i)
 	{
-		currentScope->variables.push_back({ funDef->parameters[i].paramMutable, funDef->parameters[i].identifier,  arguments[i] });
+		frameStack.PushVariable(funDef->parameters[i].paramMutable, funDef->parameters[i].identifier, arguments[i]);
 	}
 
 	InterpretBlock(funDef->block.get());
@@ -83,16 +77,11 @@ void Interpreter::InterpretFunction(const Value::Function* const function, const
 		allArguments.push_back(*lastReturnedValue);
 	}
 
-	std::wstring argumentsString;
-	for (const auto& arg : allArguments)
-	{
-		argumentsString += arg.ToPrintString() + L" ";
-	}
-	Print(L"Function from variable, Arguments: " + argumentsString);
+	Trace(TraceEventType::FunctionFromVariable, allArguments);
 
 	for (size_t i = 0; i < allArguments.size(); ++i)
 	{
-		currentScope->variables.push_back({ function->parameters[i].paramMutable, function->parameters[i].identifier,  allArguments[i] });
+		frameStack.PushVariable(function->parameters[i].paramMutable, function->parameters[i].identifier, allArguments[i]);
 	}
 
 	InterpretBlock(function->block);
@@ -102,10 +91,7 @@ void Interpreter::InterpretBlock(const Block* const block)
 {
 	currentPosition = block->startingPosition;
 	++currentDepth;
-	auto newScope = std::make_shared<Scope>();
-	newScope->higherScope = currentScope;
-	newScope->valueExpectedInCurrentFunction = newScope->higherScope->valueExpectedInCurrentFunction;
-	currentScope = std::move(newScope);
+	frameStack.PushBlockFrame();
 	for (const auto& statement : block->statements)
 	{
 		statement->InterpretThis(*this);
@@ -114,25 +100,25 @@ void Interpreter::InterpretBlock(const Block* const block)
 			break;
 		}
 	}
-	currentScope = currentScope->higherScope;
+	frameStack.PopFrame();
 	--currentDepth;
 }
 
 void Interpreter::InterpretFunctionCallStatement(const FunctionCallStatement* const functionCallStatement)
 {
 	currentPosition = functionCallStatement->startingPosition;
-	Print(L"FunctionCallStatement");
+	Trace(TraceEventType::FunctionCallStatement);
 	InterpretFunctionCall(functionCallStatement->funcCall.get(), false);
 }
 
 void Interpreter::InterpretFunctionCall(const FunctionCall* const functionCall, const bool valueExpected)
 {
 	currentPosition = functionCall->startingPosition;
-	auto function = GetFunctionDefintion(functionCall->identifier);
+	auto function = (functionCall->functionDefinition) ? functionCall->functionDefinition : GetFunctionDefintion(functionCall->identifier);
 	const Value::Function* functionFromVariable = nullptr;
 	if (!function)
 	{
-		const auto var = currentScope->GetVariable(functionCall->identifier);
+		const auto var = GetVariable(functionCall->identifier, functionCall->variableSlot);
 		if (var)
 		{
 			const auto& functionValue = var->value;
@@ -152,12 +138,9 @@ void Interpreter::InterpretFunctionCall(const FunctionCall* const functionCall,
 		}
 		if (function)
 		{
-			previousScopes.push(currentScope);
-			currentScope = std::make_shared<Scope>();
-			currentScope->valueExpectedInCurrentFunction = valueExpected;
+			frameStack.PushFunctionFrame(valueExpected);
 			InterpretFunDef(function, arguments);
-			currentScope = previousScopes.top();
-			previousScopes.pop();
+			frameStack.PopFrame();
 		}
 		else
 		{
@@ -172,19 +155,16 @@ void Interpreter::InterpretFunctionCall(const FunctionCall* const functionCall,
 
 void Interpreter::CallFunction(const Value::Function* const function, const std::vector<Value>& arguments, const bool valueExpected)
 {
-	previousScopes.push(currentScope);
-	currentScope = std::make_shared<Scope>();
-	currentScope->valueExpectedInCurrentFunction = valueExpected;
+	frameStack.PushFunctionFrame(valueExpected);
 	InterpretFunction(function, arguments);
-	currentScope = previousScopes.top();
-	previousScopes.pop();
+	frameStack.PopFrame();
 }
 
 void Interpreter::InterpretWhileLoop(const WhileLoop* const whileLoop)
 {
 	currentPosition = whileLoop->startingPosition;
 	auto conditionExpression = EvaluateExpression(whileLoop->condition.get());
-	Print(L"While " + conditionExpression.ToPrintString());
+	Trace(TraceEventType::While, conditionExpression);
 	while (conditionExpression.ToBool())
 	{
 		InterpretBlock(whileLoop->block.get());
@@ -196,12 +176,12 @@ void Interpreter::InterpretWhileLoop(const WhileLoop* const whileLoop)
 void Interpreter::InterpretReturn(const Return* const returnStatement)
 {
 	currentPosition = returnStatement->startingPosition;
-	if (currentScope->valueExpectedInCurrentFunction)
+	if (frameStack.ValueExpectedInCurrentFunction())
 	{
 		if (returnStatement->expression)
 		{
 			lastReturnedValue = EvaluateExpression(returnStatement->expression.get());
-			Print(L"Return " + lastReturnedValue->ToPrintString());
+			Trace(TraceEventType::Return, *lastReturnedValue);
 		}
 		else
 		{
@@ -211,7 +191,7 @@ void Interpreter::InterpretReturn(const Return* const returnStatement)
 	else
 	{
 		lastReturnedValue = std::nullopt;
-		Print(L"Return");
+		Trace(TraceEventType::ReturnWithoutValue);
 	}
 }
 
@@ -219,7 +199,7 @@ void Interpreter::InterpretConditional(const Conditional* const conditional)
 {
 	currentPosition = conditional->startingPosition;
 	auto conditionExpression = EvaluateExpression(conditional->condition.get());
-	Print(L"Conditional " + conditionExpression.ToPrintString());
+	Trace(TraceEventType::Conditional, conditionExpression);
 	if (conditionExpression.ToBool())
 	{
 		InterpretBlock(conditional->ifBlock.get());
@@ -233,31 +213,34 @@ void Interpreter::InterpretConditional(const Conditional* const conditional)
 void Interpreter::InterpretDeclaration(const Declaration* const declaration)
 {
 	currentPosition = declaration->startingPosition;
-	if (currentScope->VariableAlreadyExists(declaration->identifier))
+	if (!declaration->variableSlot)
 	{
-		throw InterpreterException("Redefinition of variable is not allowed.", currentPosition);
-	}
-	if (FunctionAlreadyExists(declaration->identifier))
-	{
-		throw InterpreterException("Variable can not have the same name as function does.", currentPosition);
+		if (frameStack.VariableAlreadyExists(declaration->identifier))
+		{
+			throw InterpreterException("Redefinition of variable is not allowed.", currentPosition);
+		}
+		if (FunctionAlreadyExists(declaration->identifier))
+		{
+			throw InterpreterException("Variable can not have the same name as function does.", currentPosition);
+		}
 	}
-	currentScope->variables.push_back(Variable(declaration->varMutable, declaration->identifier));
+	auto& variable = frameStack.PushVariable(declaration->varMutable, declaration->identifier);
 	if (declaration->expression)
 	{
 		auto value = EvaluateExpression(declaration->expression.get());
-		currentScope->variables.back().value = value;
-		Print(L"Declaration " + declaration->identifier + L" = " + value.ToPrintString());
+		variable.value = value;
+		Trace(TraceEventType::Declaration, declaration->identifier, value);
 	}
 	else
 	{
-		Print(L"Declaration " + declaration->identifier);
+		Trace(TraceEventType::DeclarationWithoutValue, declaration->identifier);
 	}
 }
 
 void Interpreter::InterpretAssignment(const Assignment* const assignment)
 {
 	currentPosition = assignment->startingPosition;
-	auto variable = currentScope->GetVariable(assignment->identifier);
+	auto variable = GetVariable(assignment->identifier, assignment->variableSlot);
 	if (!variable)
 	{
 		throw InterpreterException("Variable was not declared.", currentPosition);
@@ -266,52 +249,43 @@ void Interpreter::InterpretAssignment(const Assignment* const assignment)
 	{
 		throw InterpreterException("Cannot assign to immutable variable.", currentPosition);
 	}
-	variable->value = EvaluateExpression(assignment->expression.get());
-	Print(L"Assignment " + assignment->identifier + L" = " + variable->value->ToPrintString());
-}
-
-Interpreter::Variable* Interpreter::Scope::GetVariable(const std::wstring& identifier) noexcept
-{
-	for (auto& var : variables)
+	if (assignment->selfAppend && variable->value)
 	{
-		if (var.identifier == identifier)
-		{
-			return &var;
-		}
+		AppendToVariable(variable, assignment->selfAppend);
 	}
-	if (higherScope)
+	else
 	{
-		return higherScope->GetVariable(identifier);
+		variable->value = EvaluateExpression(assignment->expression.get());
 	}
-	return nullptr;
+	Trace(TraceEventType::Assignment, assignment->identifier, *variable->value);
 }
 
-bool Interpreter::Scope::VariableAlreadyExists(const std::wstring& identifier) const noexcept
+void Interpreter::AppendToVariable(Variable* const variable, const Additive* const additive)
 {
-	for (auto& var : variables)
+	// Operands may read the variable, so all of them see its value from before the assignment
+	currentPosition = additive->startingPosition;
+	if (additive->multiplicatives.size() == 2)
 	{
-		if (var.identifier == identifier)
-		{
-			return true;
-		}
+		auto operand = EvaluateMultiplicative(additive->multiplicatives.back().get());
+		*variable->value += operand;
+		return;
 	}
-	if (higherScope)
+	std::vector<Value> operands;
+	operands.reserve(additive->multiplicatives.size() - 1);
+	for (size_t i = 1; i < additive->multiplicatives.size(); ++i)
 	{
-		return higherScope->VariableAlreadyExists(identifier);
+		operands.push_back(EvaluateMultiplicative(additive->multiplicatives[i].get()));
+	}
+	for (const auto& operand : operands)
+	{
+		*variable->value += operand;
 	}
-	return false;
 }
 
-const FunctionDefiniton* Interpreter::GetFunctionDefintion(const std::wstring& identifier) const noexcept
+const FunctionDefiniton* Interpreter::GetFunctionDefintion(const Symbol identifier) const noexcept
 {
-	for (const auto function : knownFunctions)
-	{
-		if (function->identifier == identifier)
-		{
-			return function;
-		}
-	}
-	return nullptr;
+	const auto it = knownFunctions.find(identifier);
+	return (it != knownFunctions.end()) ? it->second : nullptr;
 }
 
 Value Interpreter::EvaluateExpression(const Expression* const expression)
@@ -323,6 +297,10 @@ Value Interpreter::EvaluateExpression(const Expression* const expression)
 Value Interpreter::EvaluateStandardExpression(const StandardExpression* const expression)
 {
 	currentPosition = expression->startingPosition;
+	if (!expression->lowered.empty())
+	{
+		return EvaluateExpressionNode(expression->lowered, static_cast<uint32_t>(expression->lowered.size() - 1));
+	}
 	Value currentValue = false;
 	for (const auto& conjunction : expression->conjunctions)
 	{
@@ -342,6 +320,63 @@ Value Interpreter::EvaluateStandardExpression(const StandardExpression* const ex
 	return currentValue;
 }
 
+// Operands are evaluated in the same order as in the cascade and only leaves set the position,
+// so errors are reported exactly as when the cascade is evaluated
+Value Interpreter::EvaluateExpressionNode(const std::vector<ExpressionNode>& nodes, const uint32_t index)
+{
+	using Kind = ExpressionNode::Kind;
+	const auto& node = nodes[index];
+	switch (node.kind)
+	{
+	case Kind::Literal:
+		return EvaluateLiteral(*node.literal);
+	case Kind::Factor:
+		return EvaluateFactor(node.factor);
+	case Kind::Or:
+		return EvaluateExpressionNode(nodes, node.left).ToBool() || EvaluateExpressionNode(nodes, node.right).ToBool();
+	case Kind::And:
+		return EvaluateExpressionNode(nodes, node.left).ToBool() && EvaluateExpressionNode(nodes, node.right).ToBool();
+	case Kind::Negate:
+		return -EvaluateExpressionNode(nodes, node.left);
+	case Kind::LogicalNot:
+		return !EvaluateExpressionNode(nodes, node.left);
+	default:
+		break;
+	}
+	auto currentValue = EvaluateExpressionNode(nodes, node.left);
+	const auto second = EvaluateExpressionNode(nodes, node.right);
+	switch (node.kind)
+	{
+	case Kind::Equal:
+		return currentValue == second;
+	case Kind::NotEqual:
+		return currentValue != second;
+	case Kind::Greater:
+		return currentValue > second;
+	case Kind::GreaterEqual:
+		return currentValue >= second;
+	case Kind::Less:
+		return currentValue < second;
+	case Kind::LessEqual:
+		return currentValue <= second;
+	case Kind::Add:
+		currentValue += second;
+		break;
+	case Kind::Subtract:
+		currentValue -= second;
+		break;
+	case Kind::Multiply:
+		currentValue *= second;
+		break;
+	case Kind::Divide:
+		currentValue /= second;
+		break;
+	default:
+		throw InterpreterException("Cannot handle such operator.", currentPosition);
+	}
+	return currentValue;
+}
+
 Value Interpreter::EvaluateConjunction(const Conjunction* const conjunction)
 {
 	currentPosition = conjunction->startingPosition;
@@ -402,8 +437,7 @@ Value Interpreter::EvaluateRelation(const Relation* const relation)
 Value Interpreter::EvaluateAdditive(const Additive* const additive)
 {
 	currentPosition = additive->startingPosition;
-	auto first = EvaluateMultiplicative(additive->multiplicatives.front().get());
-	auto currentValue = first;
+	auto currentValue = EvaluateMultiplicative(additive->multiplicatives.front().get());
 	for (size_t i = 0; i < additive->operators.size(); ++i)
 	{
 		switch (additive->operators[i])
@@ -449,13 +483,13 @@ Value Interpreter::EvaluateFactor(const Factor* const factor)
 {
 	currentPosition = factor->startingPosition;
 	std::optional<Value> evaluatedVal = std::nullopt;
-	if (std::holds_alternative<std::wstring>(factor->factor))
+	if (std::holds_alternative<Symbol>(factor->factor))
 	{
-		auto variable = currentScope->GetVariable(std::get<std::wstring>(factor->factor));
+		auto variable = GetVariable(std::get<Symbol>(factor->factor), factor->variableSlot);
 		if (!variable)
 		{
 			std::stringstream ss;
-			ss << "Variable '" << StringConversion::ToNarrow(std::get<std::wstring>(factor->factor)) << "' was not declared.";
+			ss << "Variable '" << StringConversion::ToNarrow(std::get<Symbol>(factor->factor).GetName()) << "' was not declared.";
 			throw InterpreterException(ss.str().c_str(), currentPosition);
 		}
 		if (variable->value)
@@ -463,7 +497,7 @@ Value Interpreter::EvaluateFactor(const Factor* const factor)
 			return *variable->value;
 		}
 		std::stringstream ss;
-		ss << "Variable '" << StringConversion::ToNarrow(std::get<std::wstring>(factor->factor)) << "' does not have value.";
+		ss << "Variable '" << StringConversion::ToNarrow(std::get<Symbol>(factor->factor).GetName()) << "' does not have value.";
 		throw InterpreterException(ss.str().c_str(), currentPosition);
 	}
 	else if (std::holds_alternative<Literal>(factor->factor))
@@ -503,6 +537,10 @@ Value Interpreter::EvaluateLiteral(const Literal& literal)
 	}
 	if (std::holds_alternative<std::wstring>(literal.value))
 	{
+		if (literal.interned)
+		{
+			return Value(literal.interned);
+		}
 		return Value(std::get<std::wstring>(literal.value));
 	}
 	if (std::holds_alternative<float>(literal.value))
@@ -568,13 +606,13 @@ Value Interpreter::EvaluateBindable(const Bindable* const bindable)
 		}
 		return *lastReturnedValue;
 	}
-	if (std::holds_alternative<std::wstring>(bindable->bindable))
+	if (std::holds_alternative<Symbol>(bindable->bindable))
 	{
-		const auto& identifier = std::get<std::wstring>(bindable->bindable);
-		auto variable = currentScope->GetVariable(identifier);
+		const auto identifier = std::get<Symbol>(bindable->bindable);
+		auto variable = GetVariable(identifier, bindable->variableSlot);
 		if (!variable)
 		{
-			auto function = GetFunction(identifier);
+			auto function = (bindable->functionDefinition) ? bindable->functionDefinition : GetFunction(identifier);
 			if (function)
 			{
 				return Value(Value::Function(function->block.get(), function->parameters));
@@ -601,25 +639,34 @@ Value Interpreter::EvaluateFunctionLiteral(const FunctionLiteral* const function
 	return Value(Value::Function(functionLiteral->block.get(), functionLiteral->parameters));
 }
 
-const FunctionDefiniton* Interpreter::GetFunction(const std::wstring& identifier) const noexcept
+Interpreter::Variable* Interpreter::GetVariable(const Symbol identifier, const std::optional<VariableSlot>& variableSlot) noexcept
 {
-	for (auto& func : knownFunctions)
+	if (variableSlot)
 	{
-		if (func->identifier == identifier)
+		if (auto variable = frameStack.GetVariable(*variableSlot))
 		{
-			return func;
+			return variable;
 		}
 	}
-	return nullptr;
+	return frameStack.GetVariable(identifier);
+}
+
+const FunctionDefiniton* Interpreter::GetFunction(const Symbol identifier) const noexcept
+{
+	return GetFunctionDefintion(identifier);
 }
 
-bool Interpreter::FunctionAlreadyExists(const std::wstring& identifier) const noexcept
+bool Interpreter::FunctionAlreadyExists(const Symbol identifier) const noexcept
 {
 	return GetFunction(identifier) != nullptr;
 }
 
-void Interpreter::Print(const std::wstring& msg) const noexcept
+size_t Interpreter::GetHeapAllocationsCount() const noexcept
+{
+	return frameStack.GetHeapAllocationsCount();
+}
+
+void Interpreter::SetTracer(Tracer* const tracer) noexcept
 {
-	std::wstring tabulation(currentDepth, L'\t');
-	std::wcout << tabulation << msg << std::endl;
+	this->tracer = tracer;
 }
\ No newline at end of file
@@ -1,33 +1,22 @@
 #pragma once
 #include "ParserObjects/ParserObjects.h"
 #include "Value.h"
-#include <stack>
+#include <unordered_map>
 #include "Position.h"
+#include "FrameStack.h"
+#include "Tracer.h"
 
 class Interpreter
 {
 public:
-	struct Variable
-	{
-		Variable(const bool isMutable, const std::wstring& identifier, std::optional<Value> value = std::nullopt) noexcept :
-			isMutable(isMutable), identifier(identifier), value(value) {
-		}
-		bool isMutable;
-		std::wstring identifier;
-		std::optional<Value> value = std::nullopt;
-	};
-	struct Scope
-	{
-		std::vector<Variable> variables;
-
-		bool valueExpectedInCurrentFunction = false;
-		std::shared_ptr<Scope> higherScope;
-		Variable* GetVariable(const std::wstring& identifier) noexcept;
-		bool VariableAlreadyExists(const std::wstring& identifier) const noexcept;
-	};
+	using Variable = FrameStack::Variable;
 
 public:
 	void Interpret(const Program* const program);
+	// Heap allocations made by the frame stack during the last Interpret
+	size_t GetHeapAllocationsCount() const noexcept;
+	// Execution trace is recorded only while tracer is set
+	void SetTracer(Tracer* const tracer) noexcept;
 
 	void InterpretBlock(const Block* const block);
 
@@ -48,11 +37,22 @@ protected:
 	void InterpretFunction(const Value::Function* const function, const std::vector<Value>& arguments);
 	void CallFunction(const Value::Function* const functionCall, const std::vector<Value>& arguments, const bool valueExpected);
 
-	void Print(const std::wstring& msg) const noexcept;
+	template<typename... Fields>
+	void Trace(const TraceEventType type, const Fields&... fields) noexcept
+	{
+		if constexpr (Tracer::compiledIn)
+		{
+			if (tracer)
+			{
+				tracer->Event(currentDepth, type, fields...);
+			}
+		}
+	}
 	void InterpretFunctionCall(const FunctionCall* const functionCall, const bool valueExpected);
-	const FunctionDefiniton* GetFunctionDefintion(const std::wstring& identifier)const noexcept;
+	const FunctionDefiniton* GetFunctionDefintion(const Symbol identifier)const noexcept;
 	Value EvaluateExpression(const Expression* const expression);
 
+	Value EvaluateExpressionNode(const std::vector<ExpressionNode>& nodes, const uint32_t index);
 	Value EvaluateConjunction(const Conjunction* const conjunction);
 	Value EvaluateRelation(const Relation* const relation);
 	Value EvaluateAdditive(const Additive* const additive);
@@ -64,13 +64,15 @@ protected:
 	Value EvaluateBindable(const Bindable* const bindable);
 	Value EvaluateFunctionLiteral(const FunctionLiteral* const functionLiteral);
 
-	const FunctionDefiniton* GetFunction(const std::wstring& identifier) const noexcept;
-	bool FunctionAlreadyExists(const std::wstring& identifier) const noexcept;
+	Variable* GetVariable(const Symbol identifier, const std::optional<VariableSlot>& variableSlot) noexcept;
+	void AppendToVariable(Variable* const variable, const Additive* const additive);
+	const FunctionDefiniton* GetFunction(const Symbol identifier) const noexcept;
+	bool FunctionAlreadyExists(const Symbol identifier) const noexcept;
 private:
 	unsigned int currentDepth = 0;
 	std::optional<Value> lastReturnedValue = std::nullopt;
-	std::shared_ptr<Scope> currentScope;
-	std::stack<std::shared_ptr<Scope>> previousScopes;
-	std::vector<const FunctionDefiniton*> knownFunctions;
+	FrameStack frameStack;
+	Tracer* tracer = nullptr;
+	std::unordered_map<Symbol, const FunctionDefiniton*> knownFunctions;
 	Position currentPosition = Position(0, 0);
 };
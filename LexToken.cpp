@@ -24,8 +24,10 @@ LexToken::LexToken(const TokenType type, const Position position, const std::wst
 {
 	switch (type)
 	{
-	case TokenType::String:
 	case TokenType::Identifier:
+		this->value = Symbol(value);
+		break;
+	case TokenType::String:
 	case TokenType::Unrecognized:
 		break;
 	default:
@@ -34,6 +36,32 @@ LexToken::LexToken(const TokenType type, const Position position, const std::wst
 	}
 }
 
+LexToken::LexToken(const TokenType type, const Position position, const Symbol value) :
+	type(type), position(position), value(value)
+{
+	switch (type)
+	{
+	case TokenType::Identifier:
+		break;
+	default:
+		throw std::runtime_error("Invalid type passed to a variant for this type of token");
+		break;
+	}
+}
+
+LexToken::LexToken(const TokenType type, const Position position, const std::wstring_view value) :
+	type(type), position(position), value(value)
+{
+	switch (type)
+	{
+	case TokenType::String:
+		break;
+	default:
+		throw std::runtime_error("Invalid type passed to a variant for this type of token");
+		break;
+	}
+}
+
 LexToken::LexToken(const TokenType type, const Position position, const int value) :
 	type(type), position(position), value(value)
 {
@@ -73,13 +101,9 @@ LexToken::LexToken(const TokenType type, const Position position, const bool val
 	}
 }
 
-std::optional<LexToken::TokenType> LexToken::FindTokenInMap(const std::wstring& key, const std::unordered_map<std::wstring, LexToken::TokenType>& map) noexcept
+LexToken::LexToken(const TokenType type, const Position position, const TokenValue& value) :
+	type(type), position(position), value(value)
 {
-	if (const auto it = map.find(key); it != map.end())
-	{
-		return it->second;
-	}
-	return std::nullopt;
 }
 
 LexToken::TokenType LexToken::GetType() const noexcept
@@ -92,7 +116,20 @@ Position LexToken::GetPosition() const noexcept
 	return position;
 }
 
-std::variant<std::monostate, std::wstring, int, float, bool> LexToken::GetValue() const noexcept
+const LexToken::TokenValue& LexToken::GetValue() const noexcept
 {
 	return value;
+}
+
+std::wstring_view LexToken::GetText() const noexcept
+{
+	if (const auto text = std::get_if<std::wstring_view>(&value))
+	{
+		return *text;
+	}
+	if (const auto text = std::get_if<std::wstring>(&value))
+	{
+		return *text;
+	}
+	return {};
 }
\ No newline at end of file
@@ -2,8 +2,9 @@
 #include "Position.h"
 #include <variant>
 #include <string>
+#include <string_view>
 #include <optional>
-#include <unordered_map>
+#include "Symbol.h"
 
 class LexToken
 {
@@ -56,21 +57,28 @@ public:
 		FunctionBind,
 		FunctionCompose
 	};
+	using TokenValue = std::variant<std::monostate, std::wstring, int, float, bool, Symbol, std::wstring_view>;
 
 	LexToken(const TokenType type, const Position position, const std::monostate value = std::monostate{});
+	// Identifier names are interned and stored as Symbol
 	LexToken(const TokenType type, const Position position, const std::wstring value);
+	LexToken(const TokenType type, const Position position, const Symbol value);
+	// String literal text viewed in place, it is owned by the Lexer which produced the token
+	LexToken(const TokenType type, const Position position, const std::wstring_view value);
 	LexToken(const TokenType type, const Position position, const int value);
 	LexToken(const TokenType type, const Position position, const float value);
 	LexToken(const TokenType type, const Position position, const bool value);
-
-	static std::optional<TokenType> FindTokenInMap(const std::wstring& key, const std::unordered_map<std::wstring, LexToken::TokenType>& map) noexcept;
+	// Rebuilds token which was stored apart, value is trusted to match the type
+	LexToken(const TokenType type, const Position position, const TokenValue& value);
 
 	TokenType GetType() const noexcept;
 	Position GetPosition() const noexcept;
-	std::variant<std::monostate, std::wstring, int, float, bool> GetValue() const noexcept;
+	const TokenValue& GetValue() const noexcept;
+	// Text of String and Unrecognized tokens whether it is owned or viewed
+	std::wstring_view GetText() const noexcept;
 
 private:
 	TokenType type;
 	Position position;
-	std::variant<std::monostate, std::wstring, int, float, bool> value;
+	TokenValue value;
 };
\ No newline at end of file
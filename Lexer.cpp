@@ -4,6 +4,7 @@
 #include <cwctype>
 #include <sstream>
 #include <array>
+#include <string_view>
 #include "OverflowChecks.h"
 // cannot use peek with wide chars
 // could do some better errors throwing to avoid code repetition
@@ -23,8 +24,14 @@ namespace
 	static constexpr unsigned int maxNumberLength = 45;
 	static constexpr unsigned int maxIdentifierLength = 45;
 
-	const std::unordered_map<std::wstring, LexToken::TokenType> keywords =
+	struct Keyword
 	{
+		std::wstring_view word;
+		LexToken::TokenType type = LexToken::TokenType::Identifier;
+	};
+
+	constexpr std::array<Keyword, 9> keywords =
+	{ {
 		{ L"mut",		LexToken::TokenType::Mut },
 		{ L"var",		LexToken::TokenType::Var },
 		{ L"while",		LexToken::TokenType::While },
@@ -34,54 +41,136 @@ namespace
 		{ L"func",		LexToken::TokenType::Func },
 		{ L"true",		LexToken::TokenType::Boolean },
 		{ L"false",		LexToken::TokenType::Boolean }
-	};
+	} };
 
-	const std::unordered_map<std::wstring, LexToken::TokenType> symbols =
-	{
-		{ L";", LexToken::TokenType::Semicolon },
-		{ L",", LexToken::TokenType::Comma },
-		{ L"{", LexToken::TokenType::LBracket },
-		{ L"}", LexToken::TokenType::RBracket },
-		{ L"[", LexToken::TokenType::LSquareBracket },
-		{ L"]", LexToken::TokenType::RSquareBracket },
-		{ L"(", LexToken::TokenType::LParenth },
-		{ L")", LexToken::TokenType::RParenth },
-		{ L"=", LexToken::TokenType::Assign },
-		{ L"+", LexToken::TokenType::Plus },
-		{ L"-", LexToken::TokenType::Minus },
-		{ L"*", LexToken::TokenType::Asterisk },
-		{ L"/", LexToken::TokenType::Slash },
-		{ L"!", LexToken::TokenType::LogicalNot },
-		{ L"<", LexToken::TokenType::Less },
-		{ L">", LexToken::TokenType::Greater },
-	};
+	// Keywords are recognized with a perfect hash, table is built and checked for collisions at compile time
+	constexpr size_t keywordTableSize = 16;
 
-	const std::unordered_map<std::wstring, LexToken::TokenType> twoCharsOperators =
-	{
-		{ L"&&", LexToken::TokenType::LogicalAnd },
-		{ L"||", LexToken::TokenType::LogicalOr },
-		{ L"==", LexToken::TokenType::Equal },
-		{ L"!=", LexToken::TokenType::NotEqual },
-		{ L"<=", LexToken::TokenType::LessEqual },
-		{ L">=", LexToken::TokenType::GreaterEqual },
-		{ L"+=", LexToken::TokenType::PlusAssign },
-		{ L"-=", LexToken::TokenType::MinusAssign },
-		{ L"*=", LexToken::TokenType::AsteriskAssign },
-		{ L"/=", LexToken::TokenType::SlashAssign },
-		{ L"&=", LexToken::TokenType::AndAssign },
-		{ L"|=", LexToken::TokenType::OrAssign },
-		{ L"<<", LexToken::TokenType::FunctionBind },
-		{ L">>", LexToken::TokenType::FunctionCompose },
-	};
+	constexpr size_t KeywordHash(const std::wstring_view word) noexcept
+	{
+		return (word.length() + static_cast<size_t>(word.front()) + 2 * static_cast<size_t>(word.back())) % keywordTableSize;
+	}
+
+	constexpr std::array<Keyword, keywordTableSize> BuildKeywordTable() noexcept
+	{
+		std::array<Keyword, keywordTableSize> table{};
+		for (const auto& keyword : keywords)
+		{
+			table[KeywordHash(keyword.word)] = keyword;
+		}
+		return table;
+	}
+
+	constexpr auto keywordTable = BuildKeywordTable();
+
+	constexpr bool IsKeywordHashPerfect() noexcept
+	{
+		for (const auto& keyword : keywords)
+		{
+			if (keywordTable[KeywordHash(keyword.word)].word != keyword.word)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	static_assert(IsKeywordHashPerfect(), "Keywords collide in the hash table, KeywordHash or keywordTableSize has to change");
+
+	constexpr std::optional<LexToken::TokenType> FindKeyword(const std::wstring_view word) noexcept
+	{
+		if (word.empty())
+		{
+			return std::nullopt;
+		}
+		const auto& candidate = keywordTable[KeywordHash(word)];
+		if (candidate.word != word)
+		{
+			return std::nullopt;
+		}
+		return candidate.type;
+	}
+
+	constexpr std::optional<LexToken::TokenType> FindSymbol(const wchar_t symbol) noexcept
+	{
+		switch (symbol)
+		{
+		case L';': return LexToken::TokenType::Semicolon;
+		case L',': return LexToken::TokenType::Comma;
+		case L'{': return LexToken::TokenType::LBracket;
+		case L'}': return LexToken::TokenType::RBracket;
+		case L'[': return LexToken::TokenType::LSquareBracket;
+		case L']': return LexToken::TokenType::RSquareBracket;
+		case L'(': return LexToken::TokenType::LParenth;
+		case L')': return LexToken::TokenType::RParenth;
+		case L'=': return LexToken::TokenType::Assign;
+		case L'+': return LexToken::TokenType::Plus;
+		case L'-': return LexToken::TokenType::Minus;
+		case L'*': return LexToken::TokenType::Asterisk;
+		case L'/': return LexToken::TokenType::Slash;
+		case L'!': return LexToken::TokenType::LogicalNot;
+		case L'<': return LexToken::TokenType::Less;
+		case L'>': return LexToken::TokenType::Greater;
+		default: return std::nullopt;
+		}
+	}
+
+	constexpr std::optional<LexToken::TokenType> FindTwoCharsOperator(const wchar_t first, const wchar_t second) noexcept
+	{
+		if (second == L'=')
+		{
+			switch (first)
+			{
+			case L'=': return LexToken::TokenType::Equal;
+			case L'!': return LexToken::TokenType::NotEqual;
+			case L'<': return LexToken::TokenType::LessEqual;
+			case L'>': return LexToken::TokenType::GreaterEqual;
+			case L'+': return LexToken::TokenType::PlusAssign;
+			case L'-': return LexToken::TokenType::MinusAssign;
+			case L'*': return LexToken::TokenType::AsteriskAssign;
+			case L'/': return LexToken::TokenType::SlashAssign;
+			case L'&': return LexToken::TokenType::AndAssign;
+			case L'|': return LexToken::TokenType::OrAssign;
+			default: return std::nullopt;
+			}
+		}
+		if (first != second)
+		{
+			return std::nullopt;
+		}
+		switch (first)
+		{
+		case L'&': return LexToken::TokenType::LogicalAnd;
+		case L'|': return LexToken::TokenType::LogicalOr;
+		case L'<': return LexToken::TokenType::FunctionBind;
+		case L'>': return LexToken::TokenType::FunctionCompose;
+		default: return std::nullopt;
+		}
+	}
+
+	static_assert(FindKeyword(L"return") == LexToken::TokenType::Return && !FindKeyword(L"retur"));
+	static_assert(FindTwoCharsOperator(L'>', L'>') == LexToken::TokenType::FunctionCompose && !FindTwoCharsOperator(L'>', L'<'));
 }
 
-Lexer::Lexer(std::wistream* const source) noexcept :
-	source(source)
-{}
+Lexer::Lexer(std::wistream* const source) noexcept
+{
+	this->source.Reset(source);
+}
+
+Lexer::Lexer(const std::wstring_view text, const Position start) noexcept
+	: currentPosition(start)
+{
+	source.Reset(text);
+}
+
+Lexer::Lexer(const std::string_view utf8Text, const Position start) noexcept
+	: currentPosition(start)
+{
+	source.Reset(utf8Text);
+}
 
 void Lexer::SetNewSource(std::wistream* const newSource) noexcept
 {
-	source = newSource;
+	source.Reset(newSource);
 	currentPosition.line = 1;
 	currentPosition.column = 1;
 }
@@ -107,11 +196,39 @@ std::pair<std::vector<LexToken>, std::vector<LexicalError>> Lexer::ResolveAllRem
 	return { resolvedTokens, foundErrors };
 }
 
+TokenBuffer Lexer::Tokenize()
+{
+	TokenBuffer tokens;
+	do
+	{
+		currentErrors.clear();
+		const auto token = ResolveNextToken();
+		for (const auto& error : currentErrors)
+		{
+			tokens.PushError(error);
+		}
+		tokens.Push(token);
+		if (!currentErrors.empty() && currentErrors.back().IsTerminating())
+		{
+			break;
+		}
+	} while (tokens.GetType(tokens.GetSize() - 1) != LexToken::TokenType::EndOfFile);
+
+	return tokens;
+}
+
 std::pair<LexToken, std::vector<LexicalError>> Lexer::ResolveNext()
 {
 	currentErrors.clear();
+	auto token = ResolveNextToken();
+	return { std::move(token), currentErrors };
+}
 
-	while (source->get(currentChar))
+LexToken Lexer::ResolveNextToken()
+{
+	// Whitespace runs are skipped in bulk, the loop only sees what is left
+	source.SkipWhitespace(currentPosition);
+	while (source.Get(currentChar))
 	{
 		if (std::isspace(currentChar))
 		{
@@ -127,10 +244,10 @@ std::pair<LexToken, std::vector<LexicalError>> Lexer::ResolveNext()
 			continue;
 		}
 
-		return { BuildToken(), currentErrors };
+		return BuildToken();
 	}
 
-	return { LexToken(LexToken::TokenType::EndOfFile, currentPosition), currentErrors };
+	return LexToken(LexToken::TokenType::EndOfFile, currentPosition);
 }
 
 std::optional<LexToken> Lexer::TryBuildComment()
@@ -140,20 +257,11 @@ std::optional<LexToken> Lexer::TryBuildComment()
 		return std::nullopt;
 	}
 
-	unsigned int commentLength = 0;
-	while (source->get(currentChar) && currentChar != L'\n')
-	{
-		++commentLength;
-		if (commentLength > maxCommentLength)
-		{
-			const auto errorPosition = currentPosition;
-			const auto token = LexToken(LexToken::TokenType::Comment, currentPosition);
-			const bool skippedSuccessfully = SkipComment();
-			currentErrors.push_back(LexicalError(LexicalError::ErrorType::CommentTooLong, errorPosition, !skippedSuccessfully));
-			return token;
-		}
-	};
 	const auto token = LexToken(LexToken::TokenType::Comment, currentPosition);
+	if (!source.SkipPast('\n', maxCommentLength))
+	{
+		currentErrors.push_back(LexicalError(LexicalError::ErrorType::CommentTooLong, currentPosition, false));
+	}
 	++currentPosition.line;
 	currentPosition.column = 1;
 	return token;
@@ -177,7 +285,7 @@ std::optional<LexToken> Lexer::TryBuildNumber()
 
 	float builtValueFloat = 0.f;
 
-	while (source->get(currentChar))
+	while (source.Get(currentChar))
 	{
 		if (std::iswdigit(currentChar))
 		{
@@ -257,7 +365,7 @@ std::optional<LexToken> Lexer::TryBuildNumber()
 			}
 			else
 			{
-				source->unget();
+				source.Unget();
 				break;
 			}
 		}
@@ -287,44 +395,47 @@ std::optional<LexToken> Lexer::TryBuildWord()
 		return std::nullopt;
 	}
 
-	std::wstring word{ currentChar };
-	while (source->get(currentChar) && (std::iswalnum(currentChar) || currentChar == L'_'))
+	// Word is gathered on the stack, identifiers are interned straight from it
+	std::array<wchar_t, maxIdentifierLength + 1> word;
+	size_t wordLength = 0;
+	word[wordLength++] = currentChar;
+	while (source.Get(currentChar) && (std::iswalnum(currentChar) || currentChar == L'_'))
 	{
-		word += currentChar;
-		if (word.length() > maxIdentifierLength)
+		word[wordLength++] = currentChar;
+		if (wordLength > maxIdentifierLength)
 		{
 			const auto errorPosition = currentPosition;
 			const auto token = LexToken(LexToken::TokenType::Unrecognized, currentPosition);
-			currentPosition.column += word.length();
+			currentPosition.column += wordLength;
 			const bool skippedSuccessfully = SkipIdentifier();
 			currentErrors.push_back(LexicalError(LexicalError::ErrorType::IdentifierTooLong, errorPosition, !skippedSuccessfully));
 			return token;
 		}
 	}
-	source->unget();
+	source.Unget();
 
-	if (const auto tokenTypeOpt = LexToken::FindTokenInMap(word, keywords))
+	const std::wstring_view wordView(word.data(), wordLength);
+	if (const auto tokenTypeOpt = FindKeyword(wordView))
 	{
 		if (*tokenTypeOpt == LexToken::TokenType::Boolean)
 		{
-			const auto token = LexToken(LexToken::TokenType::Boolean, currentPosition, (word == L"true"));
-			currentPosition.column += word.length();
+			const auto token = LexToken(LexToken::TokenType::Boolean, currentPosition, (wordView == L"true"));
+			currentPosition.column += wordLength;
 			return token;
 		}
 		const auto token = LexToken(*tokenTypeOpt, currentPosition);
-		currentPosition.column += word.length();
+		currentPosition.column += wordLength;
 		return token;
 	}
 
-	const auto token = LexToken(LexToken::TokenType::Identifier, currentPosition, word);
-	currentPosition.column += word.length();
+	const auto token = LexToken(LexToken::TokenType::Identifier, currentPosition, Symbol(wordView));
+	currentPosition.column += wordLength;
 	return token;
 }
 
 std::optional<LexToken> Lexer::TryBuildSingleSymbol()
 {
-	auto symbol = std::wstring{ currentChar };
-	if (const auto tokenType = LexToken::FindTokenInMap({ currentChar }, symbols))
+	if (const auto tokenType = FindSymbol(currentChar))
 	{
 		const auto token = LexToken(*tokenType, currentPosition);
 		currentPosition.column++;
@@ -337,16 +448,16 @@ std::optional<LexToken> Lexer::TryBuildSingleSymbol()
 std::optional<LexToken> Lexer::TryBuildTwoCharsOperator()
 {
 	wchar_t nextChar;
-	if (source->get(nextChar))
+	if (source.Get(nextChar))
 	{
-		if (const auto tokenType = LexToken::FindTokenInMap({ currentChar, nextChar }, twoCharsOperators))
+		if (const auto tokenType = FindTwoCharsOperator(currentChar, nextChar))
 		{
 			const auto token = LexToken(*tokenType, currentPosition);
 			currentPosition.column += 2;
 			return token;
 		}
 	}
-	source->unget();
+	source.Unget();
 	return std::nullopt;
 }
 
@@ -369,34 +480,43 @@ std::optional<LexToken> Lexer::TryBuildStringLiteral()
 		return std::nullopt;
 	}
 
-	std::wstring builtString;
+	// Text is unescaped straight into the literal block, nothing is allocated per token
+	wchar_t* const builtString = ReserveLiteralText();
+	size_t builtLength = 0;
 	unsigned int escapeSequencesAdditionalLength = 0;
 
-	while (source->get(currentChar))
+	while (true)
 	{
-		if (builtString.length() > maxStringLiteralLength)
+		// Plain text is copied in runs, limit is still hit on the same character as when copying one by one
+		builtLength += source.CopyStringLiteralRun(builtString + builtLength, maxStringLiteralLength + 1 - builtLength);
+		if (!source.Get(currentChar))
+		{
+			break;
+		}
+		if (builtLength > maxStringLiteralLength)
 		{
 			const auto errorPosition = currentPosition;
 			const auto token = LexToken(LexToken::TokenType::Unrecognized, currentPosition);
-			currentPosition.column += builtString.length() + escapeSequencesAdditionalLength + 2;
+			currentPosition.column += builtLength + escapeSequencesAdditionalLength + 2;
 			const bool skippedSuccessfully = SkipStringLiteral();
 			currentErrors.push_back(LexicalError(LexicalError::ErrorType::StringLiteralTooLong, errorPosition, !skippedSuccessfully));
 			return token;
 		}
 		if (currentChar == L'"')
 		{
-			const auto token = LexToken(LexToken::TokenType::String, currentPosition, builtString);
-			currentPosition.column += builtString.length() + escapeSequencesAdditionalLength + 2;
+			const auto token = LexToken(LexToken::TokenType::String, currentPosition, std::wstring_view(builtString, builtLength));
+			literalBlockUsed += builtLength;
+			currentPosition.column += builtLength + escapeSequencesAdditionalLength + 2;
 			return token;
 		}
 		if (currentChar == L'\\')
 		{
-			if (source->get(currentChar))
+			if (source.Get(currentChar))
 			{
 				static constexpr std::array<wchar_t, 4> handledEscapedChars = { L'"',  L'\\', L'n', L't' };
 				if (std::find(handledEscapedChars.begin(), handledEscapedChars.end(), currentChar) == handledEscapedChars.end())
 				{
-					currentErrors.push_back(LexicalError(LexicalError::ErrorType::InvalidEscapeSequence, Position(currentPosition.line, currentPosition.column + builtString.length())));
+					currentErrors.push_back(LexicalError(LexicalError::ErrorType::InvalidEscapeSequence, Position(currentPosition.line, currentPosition.column + builtLength)));
 				}
 				else
 				{
@@ -405,13 +525,13 @@ std::optional<LexToken> Lexer::TryBuildStringLiteral()
 				switch (currentChar)
 				{
 				case L'n':
-					builtString.push_back(L'\n');
+					builtString[builtLength++] = L'\n';
 					break;
 				case L't':
-					builtString.push_back(L'\t');
+					builtString[builtLength++] = L'\t';
 					break;
 				default:
-					builtString.push_back(currentChar);
+					builtString[builtLength++] = currentChar;
 					break;
 				}
 			}
@@ -422,12 +542,12 @@ std::optional<LexToken> Lexer::TryBuildStringLiteral()
 		}
 		else
 		{
-			builtString += currentChar;
+			builtString[builtLength++] = currentChar;
 		}
 	}
 	currentErrors.push_back(LexicalError(LexicalError::ErrorType::IncompleteStringLiteral, currentPosition));
 	const auto token = LexToken(LexToken::TokenType::Unrecognized, currentPosition);
-	currentPosition.column += builtString.length() + escapeSequencesAdditionalLength + 1;
+	currentPosition.column += builtLength + escapeSequencesAdditionalLength + 1;
 	return token;
 }
 
@@ -461,6 +581,18 @@ LexToken Lexer::BuildToken()
 	return *token;
 }
 
+wchar_t* Lexer::ReserveLiteralText()
+{
+	static constexpr size_t literalBlockSize = 16 * 1024;
+	// Literal longer than the limit is rejected after one more character was stored
+	if (literalBlocks.empty() || literalBlockSize - literalBlockUsed < maxStringLiteralLength + 1)
+	{
+		literalBlocks.push_back(std::make_unique<wchar_t[]>(literalBlockSize));
+		literalBlockUsed = 0;
+	}
+	return literalBlocks.back().get() + literalBlockUsed;
+}
+
 bool Lexer::SkipNumber(bool dotOccured)
 {
 	bool dotOccurred = false;
@@ -468,7 +600,7 @@ bool Lexer::SkipNumber(bool dotOccured)
 	static constexpr int maxSafety = 200;
 	unsigned int alreadySkipped = 0;
 
-	while (source->get(currentChar))
+	while (source.Get(currentChar))
 	{
 		++alreadySkipped;
 		if (alreadySkipped > maxSafety)
@@ -490,33 +622,20 @@ bool Lexer::SkipNumber(bool dotOccured)
 		}
 
 		--currentPosition.column;
-		source->unget();
+		source.Unget();
 		break;
 	}
 
 	return true; // Successfully skipped number
 }
 
-bool Lexer::SkipComment()
-{
-	static constexpr int maxSafety = 5000;
-	source->ignore(std::numeric_limits<std::streamsize>::max(), L'\n');
-	const bool skipSuccessfull = !source->fail() || source->eof();
-	if (skipSuccessfull)
-	{
-		currentPosition.column = 1;
-		++currentPosition.line;
-	}
-	return skipSuccessfull;
-}
-
 bool Lexer::SkipStringLiteral()
 {
 	static constexpr int maxSafety = 5000;
 	unsigned int alreadySkipped = 0;
 	wchar_t prevChar = 0;
 
-	while (source->get(currentChar))
+	while (source.Get(currentChar))
 	{
 		++alreadySkipped;
 		if (alreadySkipped > maxSafety)
@@ -541,7 +660,7 @@ bool Lexer::SkipIdentifier()
 	static constexpr int maxSafety = 200;
 	unsigned int alreadySkipped = 0;
 
-	while (source->get(currentChar))
+	while (source.Get(currentChar))
 	{
 		++alreadySkipped;
 		if (alreadySkipped > maxSafety)
@@ -553,7 +672,7 @@ bool Lexer::SkipIdentifier()
 		if (!std::iswalnum(currentChar) && currentChar != L'_')
 		{
 			--currentPosition.column;
-			source->unget();
+			source.Unget();
 			return true;
 		}
 	}
@@ -2,21 +2,30 @@
 #include <variant>
 #include <string>
 #include <vector>
+#include <memory>
 #include <optional>
-#include <unordered_map>
 #include "Position.h"
 #include "LexToken.h"
 #include "LexicalError.h"
+#include "LexerSource.h"
+#include "TokenBuffer.h"
 
 class Lexer
 {
 public:
 	Lexer(std::wistream* const  source) noexcept;
+	// Lexes text in place, it has to outlive the Lexer. Start is the position of the text in a larger source
+	explicit Lexer(const std::wstring_view text, const Position start = Position(1, 1)) noexcept;
+	// Lexes UTF-8 text in place (e.g. MappedFile contents), it has to outlive the Lexer
+	explicit Lexer(const std::string_view utf8Text, const Position start = Position(1, 1)) noexcept;
 	void SetNewSource(std::wistream* const  newSource) noexcept;
 
 	std::pair<std::vector<LexToken>, std::vector<LexicalError>> ResolveAllRemaining();
 	std::pair<LexToken, std::vector<LexicalError>> ResolveNext();
+	// Lexes whole remaining source into one buffer, stops on terminating error same as ResolveAllRemaining
+	TokenBuffer Tokenize();
 private:
+	LexToken ResolveNextToken();
 	LexToken BuildToken();
 
 	std::optional<LexToken> TryBuildComment();
@@ -28,13 +37,17 @@ private:
 	std::optional<LexToken> TryBuildStringLiteral();
 
 	bool SkipNumber(bool dotOccured);
-	bool SkipComment();
 	bool SkipStringLiteral();
 	bool SkipIdentifier();
 
+	wchar_t* ReserveLiteralText();
+
 private:
-	std::wistream* source = nullptr;
+	LexerSource source;
 	std::vector<LexicalError> currentErrors;
 	wchar_t currentChar = {};
 	Position currentPosition = { 1, 1 };
+	// String literal texts viewed by tokens, blocks are kept for the whole Lexer lifetime
+	std::vector<std::unique_ptr<wchar_t[]>> literalBlocks;
+	size_t literalBlockUsed = 0;
 };
\ No newline at end of file
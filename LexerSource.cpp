@@ -0,0 +1,240 @@
+#include "LexerSource.h"
+#include "CharScan.h"
+#include <algorithm>
+#include <iterator>
+
+namespace
+{
+	// Same as moving over the characters one by one: newline starts next line, anything else moves the column
+	template<typename Char>
+	void MovePosition(const Char* const from, const Char* const to, Position& position)
+	{
+		const auto afterLastNewline = std::find(std::make_reverse_iterator(to), std::make_reverse_iterator(from), Char('\n')).base();
+		if (afterLastNewline == from)
+		{
+			position.column += to - from;
+			return;
+		}
+		position.line += std::count(from, afterLastNewline, Char('\n'));
+		position.column = 1 + (to - afterLastNewline);
+	}
+}
+
+void LexerSource::Reset(std::wistream* const stream) noexcept
+{
+	this->stream = stream;
+	begin = current = end = nullptr;
+	utf8 = false;
+	failed = false;
+}
+
+void LexerSource::Reset(const std::wstring_view text) noexcept
+{
+	stream = nullptr;
+	begin = current = text.data();
+	end = text.data() + text.size();
+	utf8 = false;
+	failed = false;
+}
+
+void LexerSource::Reset(const std::string_view utf8Text) noexcept
+{
+	stream = nullptr;
+	begin = current = end = nullptr;
+	previousByte = currentByte = utf8Text.data();
+	endByte = utf8Text.data() + utf8Text.size();
+	// Byte order mark is not part of the program
+	if (utf8Text.substr(0, 3) == "\xEF\xBB\xBF")
+	{
+		previousByte = currentByte += 3;
+	}
+	utf8 = true;
+	failed = false;
+}
+
+void LexerSource::SkipWhitespace(Position& position)
+{
+	if (failed)
+	{
+		return;
+	}
+	if (utf8)
+	{
+		const auto stop = CharScan::SkipWhitespace(currentByte, endByte);
+		if (stop != currentByte)
+		{
+			MovePosition(currentByte, stop, position);
+			previousByte = stop - 1;
+			currentByte = stop;
+		}
+		return;
+	}
+	while (current != end || Refill())
+	{
+		const auto stop = CharScan::SkipWhitespace(current, end);
+		MovePosition(current, stop, position);
+		current = stop;
+		if (stop != end)
+		{
+			return;
+		}
+	}
+}
+
+bool LexerSource::SkipPast(const char delimiter, const size_t maxLength)
+{
+	if (failed)
+	{
+		return true;
+	}
+	if (utf8)
+	{
+		// Bytes of multibyte UTF-8 sequences never match an ASCII delimiter, so they are skipped undecoded
+		const auto found = CharScan::Find(currentByte, endByte, delimiter);
+		bool withinLength = static_cast<size_t>(found - currentByte) <= maxLength;
+		if (!withinLength)
+		{
+			// Byte count only bounds the character count, long runs are decoded to count exactly
+			size_t length = 0;
+			wchar_t character;
+			while (currentByte != found && GetUtf8(character))
+			{
+				++length;
+			}
+			withinLength = length <= maxLength;
+		}
+		if (found != endByte)
+		{
+			previousByte = found;
+			currentByte = found + 1;
+		}
+		else
+		{
+			currentByte = endByte;
+		}
+		return withinLength;
+	}
+	size_t length = 0;
+	while (current != end || Refill())
+	{
+		const auto found = CharScan::Find(current, end, static_cast<wchar_t>(delimiter));
+		length += found - current;
+		if (found != end)
+		{
+			current = found + 1;
+			break;
+		}
+		current = end;
+	}
+	return length <= maxLength;
+}
+
+size_t LexerSource::CopyStringLiteralRun(wchar_t* const destination, const size_t maxCount)
+{
+	if (failed)
+	{
+		return 0;
+	}
+	if (utf8)
+	{
+		const auto limit = currentByte + std::min(maxCount, static_cast<size_t>(endByte - currentByte));
+		const auto stop = CharScan::FindStringLiteralStop(currentByte, limit);
+		// Only ASCII bytes are in the run, they map to characters one to one
+		std::copy(currentByte, stop, destination);
+		const auto copied = static_cast<size_t>(stop - currentByte);
+		if (copied != 0)
+		{
+			previousByte = stop - 1;
+			currentByte = stop;
+		}
+		return copied;
+	}
+	size_t copied = 0;
+	while (copied < maxCount && (current != end || Refill()))
+	{
+		const auto limit = current + std::min(maxCount - copied, static_cast<size_t>(end - current));
+		const auto stop = CharScan::FindStringLiteralStop(current, limit);
+		std::copy(current, stop, destination + copied);
+		copied += stop - current;
+		current = stop;
+		if (stop != limit)
+		{
+			break;
+		}
+	}
+	return copied;
+}
+
+bool LexerSource::Refill()
+{
+	if (!stream || failed)
+	{
+		return false;
+	}
+	if (block.empty())
+	{
+		block.resize(blockSize + 1);
+	}
+	// Last character is carried to the front of the new block, so it can still be ungot
+	size_t kept = 0;
+	if (current != begin)
+	{
+		block[0] = current[-1];
+		kept = 1;
+	}
+	stream->read(block.data() + kept, blockSize);
+	const auto count = static_cast<size_t>(stream->gcount());
+	begin = block.data();
+	current = begin + kept;
+	end = current + count;
+	return count > 0;
+}
+
+wchar_t LexerSource::DecodeUtf8Sequence() noexcept
+{
+	constexpr wchar_t replacement = 0xFFFD;
+	const auto lead = static_cast<unsigned char>(*currentByte++);
+	size_t length;
+	char32_t codePoint;
+	if ((lead & 0xE0) == 0xC0)
+	{
+		length = 1;
+		codePoint = lead & 0x1F;
+	}
+	else if ((lead & 0xF0) == 0xE0)
+	{
+		length = 2;
+		codePoint = lead & 0x0F;
+	}
+	else if ((lead & 0xF8) == 0xF0)
+	{
+		length = 3;
+		codePoint = lead & 0x07;
+	}
+	else
+	{
+		return replacement;
+	}
+	for (size_t i = 0; i < length; ++i)
+	{
+		if (currentByte == endByte || (static_cast<unsigned char>(*currentByte) & 0xC0) != 0x80)
+		{
+			return replacement;
+		}
+		codePoint = (codePoint << 6) | (static_cast<unsigned char>(*currentByte++) & 0x3F);
+	}
+	constexpr char32_t minimalCodePoint[] = { 0x80, 0x800, 0x10000 };
+	if (codePoint < minimalCodePoint[length - 1] || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+	{
+		return replacement;
+	}
+	// Characters outside of the basic plane do not fit into 16 bit wchar_t
+	if constexpr (sizeof(wchar_t) < 4)
+	{
+		if (codePoint > 0xFFFF)
+		{
+			return replacement;
+		}
+	}
+	return static_cast<wchar_t>(codePoint);
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <istream>
+#include <string_view>
+#include <vector>
+#include "Position.h"
+
+// Characters consumed by the Lexer, read by pointer from a contiguous buffer.
+// Stream sources are pulled in large blocks instead of one character per std::wistream::get,
+// text sources are lexed in place. Mirrors the stream behaviour the Lexer relies on:
+// single character can be ungot and once reading failed at the end, source stays failed.
+class LexerSource
+{
+public:
+	void Reset(std::wistream* const stream) noexcept;
+	// Text has to outlive the lexing
+	void Reset(const std::wstring_view text) noexcept;
+	// UTF-8 bytes are read in place as well, only non-ASCII sequences need decoding
+	void Reset(const std::string_view utf8Text) noexcept;
+
+	bool Get(wchar_t& character)
+	{
+		if (utf8)
+		{
+			return GetUtf8(character);
+		}
+		if (current == end && !Refill())
+		{
+			failed = true;
+			return false;
+		}
+		if (failed)
+		{
+			return false;
+		}
+		character = *current++;
+		return true;
+	}
+
+	void Unget() noexcept
+	{
+		if (utf8)
+		{
+			if (!failed)
+			{
+				currentByte = previousByte;
+			}
+		}
+		else if (!failed && current != begin)
+		{
+			--current;
+		}
+	}
+
+	// Consumes whitespace run (same set as std::isspace in the "C" locale), position is moved over it
+	void SkipWhitespace(Position& position);
+	// Consumes characters up to and including ASCII delimiter or to the end of the source,
+	// returns false when more than maxLength characters preceded the delimiter
+	bool SkipPast(const char delimiter, const size_t maxLength);
+	// Copies characters up to the first quote, backslash or multibyte UTF-8 sequence, at most maxCount of them
+	size_t CopyStringLiteralRun(wchar_t* const destination, const size_t maxCount);
+
+private:
+	bool Refill();
+
+	bool GetUtf8(wchar_t& character)
+	{
+		if (failed || currentByte == endByte)
+		{
+			failed = true;
+			return false;
+		}
+		previousByte = currentByte;
+		const auto byte = static_cast<unsigned char>(*currentByte);
+		if (byte < 0x80)
+		{
+			character = static_cast<wchar_t>(byte);
+			++currentByte;
+			return true;
+		}
+		character = DecodeUtf8Sequence();
+		return true;
+	}
+	wchar_t DecodeUtf8Sequence() noexcept;
+
+	static constexpr size_t blockSize = 64 * 1024;
+
+	std::wistream* stream = nullptr;
+	std::vector<wchar_t> block;
+	const wchar_t* begin = nullptr;
+	const wchar_t* current = nullptr;
+	const wchar_t* end = nullptr;
+
+	bool utf8 = false;
+	const char* previousByte = nullptr;
+	const char* currentByte = nullptr;
+	const char* endByte = nullptr;
+
+	bool failed = false;
+};
@@ -8,8 +8,25 @@
 #include "PathConfig.h"
 #include "Parser.h"
 #include "Interpreter.h"
+#include "VirtualMachine.h"
+#include <cstring>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "TraceDecoder.h"
+#include "MappedFile.h"
+#include "ParallelParser.h"
+#include "ProgramImage.h"
+#include "ParseCache.h"
 
-int main()
+// Program file is memory mapped and lexed as UTF-8, pass --wifstream to read it through std::wifstream instead
+// Pass --parallel to parse functions of the mapped file on all cores
+// Pass --image <path> to load the parsed program from binary image made for the same source, the image is written when it is missing or stale
+// Pass --cache <directory> to keep images of all run scripts in the directory, --cache-stats to print its hits and misses
+// Pass --ast-stats to print how many nodes and bytes the parsed program takes
+// Pass --vm to execute the program with bytecode VirtualMachine instead of tree-walking Interpreter
+// Pass --trace to print execution trace, --trace-file <path> to save it in binary form for TraceDecoderTool
+int main(int argc, char* argv[])
 {
 	/*std::string codeExample = R"(
 		mut var a;
@@ -23,21 +40,176 @@ int main()
 	std::istringstream codeStream(codeExample);
 	const auto tokens = lexer.Tokenize(codeStream*/
 
-	std::wifstream codeFile(CodesPath::exampleCodesPath + "TestCode3.txt");
-	if (!codeFile.is_open()) {
+	bool useVirtualMachine = false;
+	bool useWideStream = false;
+	bool parseInParallel = false;
+	bool printAstStats = false;
+	bool printTrace = false;
+	std::ofstream traceFile;
+	std::string imagePath;
+	std::string cacheDirectory;
+	bool printCacheStats = false;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--vm") == 0)
+		{
+			useVirtualMachine = true;
+		}
+		else if (std::strcmp(argv[i], "--wifstream") == 0)
+		{
+			useWideStream = true;
+		}
+		else if (std::strcmp(argv[i], "--parallel") == 0)
+		{
+			parseInParallel = true;
+		}
+		else if (std::strcmp(argv[i], "--ast-stats") == 0)
+		{
+			printAstStats = true;
+		}
+		else if (std::strcmp(argv[i], "--image") == 0 && i + 1 < argc)
+		{
+			imagePath = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--cache") == 0 && i + 1 < argc)
+		{
+			cacheDirectory = argv[++i];
+		}
+		else if (std::strcmp(argv[i], "--cache-stats") == 0)
+		{
+			printCacheStats = true;
+		}
+		else if (std::strcmp(argv[i], "--trace") == 0)
+		{
+			printTrace = true;
+		}
+		else if (std::strcmp(argv[i], "--trace-file") == 0 && i + 1 < argc)
+		{
+			traceFile.open(argv[++i], std::ios::binary);
+		}
+	}
+
+	const std::string codePath = CodesPath::exampleCodesPath + "TestCode3.txt";
+	std::wifstream codeStream;
+	MappedFile codeFile;
+	if (useWideStream)
+	{
+		codeStream.open(codePath);
+	}
+	else
+	{
+		codeFile.Open(codePath);
+	}
+	if (!codeStream.is_open() && !codeFile.IsOpen()) {
 		std::cerr << "Error opening file!" << std::endl;
 		return 1;
 	}
 
-	Lexer lexer = Lexer(&codeFile);
+	// Cache and image are checked against hash of the mapped source, so they can not be used with the stream
+	const bool useImage = !imagePath.empty() && !useWideStream;
+	const auto sourceHash = useImage ? ProgramImage::HashSource(codeFile.GetText()) : 0;
+	const auto parseCache = !cacheDirectory.empty() && !useWideStream ? std::make_unique<ParseCache>(cacheDirectory) : nullptr;
+	std::unique_ptr<Program> program;
+	if (parseCache)
+	{
+		program = parseCache->Load(codeFile.GetText());
+	}
+	// Image is tried on a cache miss, source is parsed and both are written only when neither of them is valid
+	if (!program && useImage)
+	{
+		program = ProgramImage::Load(imagePath, sourceHash);
+		if (program && parseCache && !parseCache->Store(*program, codeFile.GetText()))
+		{
+			std::cerr << "Could not store program in parse cache " << cacheDirectory << std::endl;
+		}
+	}
+	else if (!program && parseInParallel && !useWideStream)
+	{
+		program = ParallelParser().ParseProgram(codeFile.GetText());
+	}
+	if (!program)
+	{
+		Lexer lexer = useWideStream ? Lexer(&codeStream) : Lexer(codeFile.GetText());
+
+		// Whole file is lexed up front, parser then scans the token buffer
+		const TokenBuffer tokens = lexer.Tokenize();
+		Parser parser = Parser(&tokens);
 
-	Parser parser = Parser(&lexer);
+		program = parser.ParseProgram();
+		// Programs with errors are not stored, so the errors are reported on every run
+		if (parseCache && !parser.HadErrors() && !parseCache->Store(*program, codeFile.GetText()))
+		{
+			std::cerr << "Could not store program in parse cache " << cacheDirectory << std::endl;
+		}
+		if (useImage && !parser.HadErrors() && !ProgramImage::Write(*program, sourceHash, imagePath))
+		{
+			std::cerr << "Could not write program image " << imagePath << std::endl;
+		}
+	}
+	if (parseCache && printCacheStats)
+	{
+		const auto totals = parseCache->ReadTotalStatistics();
+		std::cerr << "Parse cache: " << (parseCache->GetStatistics().hits > 0 ? "hit" : "miss") << ", all runs: "
+			<< totals.hits << " hits, " << totals.misses << " misses" << std::endl;
+	}
+	if (printAstStats)
+	{
+		std::cerr << "AST: " << program->arena.GetNodeCount() << " nodes, " << program->arena.GetByteCount() << " bytes ("
+			<< program->arena.GetReservedByteCount() << " reserved)" << std::endl;
+	}
+
+	// Trace records are drained from the ring by separate thread while the program runs
+	TraceRing traceRing;
+	Tracer tracer(traceRing);
+	const bool tracing = printTrace || traceFile.is_open();
+	std::atomic<bool> executionFinished = false;
+	std::thread traceConsumer;
+	if (tracing)
+	{
+		traceConsumer = std::thread([&]()
+		{
+			std::vector<uint8_t> records;
+			bool finished = false;
+			do
+			{
+				finished = executionFinished.load();
+				records.clear();
+				traceRing.Read(records);
+				if (traceFile.is_open())
+				{
+					traceFile.write(reinterpret_cast<const char*>(records.data()), records.size());
+				}
+				if (printTrace)
+				{
+					TraceDecoder::Decode(records.data(), records.size(), std::wcout);
+				}
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			} while (!finished);
+		});
+	}
 
-	auto program = parser.ParseProgram();
+	if (useVirtualMachine)
+	{
+		VirtualMachine virtualMachine;
+		virtualMachine.SetTracer(tracing ? &tracer : nullptr);
+		virtualMachine.Interpret(program.get());
+	}
+	else
+	{
+		Interpreter interpreter;
+		interpreter.SetTracer(tracing ? &tracer : nullptr);
+		interpreter.Interpret(program.get());
+	}
 
-	Interpreter interpreter;
-	interpreter.Interpret(program.get());
+	if (tracing)
+	{
+		executionFinished = true;
+		traceConsumer.join();
+		if (traceRing.GetDroppedCount() > 0)
+		{
+			std::cerr << traceRing.GetDroppedCount() << " trace events were dropped" << std::endl;
+		}
+	}
 
-	codeFile.close();
 	return 0;
 }
\ No newline at end of file
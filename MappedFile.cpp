@@ -0,0 +1,117 @@
+#include "MappedFile.h"
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+bool MappedFile::Open(const std::string& path)
+{
+	Close();
+#if defined(_WIN32)
+	const HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize))
+	{
+		CloseHandle(file);
+		return false;
+	}
+	fileHandle = file;
+	open = true;
+	size = static_cast<size_t>(fileSize.QuadPart);
+	// Empty files cannot be mapped, they are still opened with an empty view
+	if (size == 0)
+	{
+		return true;
+	}
+	mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mappingHandle)
+	{
+		data = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+	}
+#else
+	const int file = ::open(path.c_str(), O_RDONLY);
+	if (file < 0)
+	{
+		return false;
+	}
+	struct stat status;
+	if (fstat(file, &status) != 0)
+	{
+		::close(file);
+		return false;
+	}
+	open = true;
+	size = static_cast<size_t>(status.st_size);
+	// Empty files cannot be mapped, they are still opened with an empty view
+	if (size > 0)
+	{
+		void* const mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+		if (mapping != MAP_FAILED)
+		{
+			madvise(mapping, size, MADV_SEQUENTIAL);
+			data = static_cast<const char*>(mapping);
+		}
+	}
+	// Mapping keeps its own reference to the file
+	::close(file);
+#endif
+	if (size > 0 && !data)
+	{
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void MappedFile::Close() noexcept
+{
+#if defined(_WIN32)
+	if (data)
+	{
+		UnmapViewOfFile(data);
+	}
+	if (mappingHandle)
+	{
+		CloseHandle(mappingHandle);
+	}
+	if (fileHandle)
+	{
+		CloseHandle(fileHandle);
+	}
+	mappingHandle = nullptr;
+	fileHandle = nullptr;
+#else
+	if (data)
+	{
+		munmap(const_cast<char*>(data), size);
+	}
+#endif
+	data = nullptr;
+	size = 0;
+	open = false;
+}
+
+bool MappedFile::IsOpen() const noexcept
+{
+	return open;
+}
+
+std::string_view MappedFile::GetText() const noexcept
+{
+	return std::string_view(data, size);
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <string>
+#include <string_view>
+
+// Read-only memory mapping of a whole file, the view stays valid until the file is closed
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	~MappedFile();
+
+	bool Open(const std::string& path);
+	void Close() noexcept;
+	bool IsOpen() const noexcept;
+	std::string_view GetText() const noexcept;
+
+private:
+	const char* data = nullptr;
+	size_t size = 0;
+	bool open = false;
+#if defined(_WIN32)
+	void* fileHandle = nullptr;
+	void* mappingHandle = nullptr;
+#endif
+};
@@ -0,0 +1,205 @@
+#include "ParallelParser.h"
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include "Parser.h"
+#include "Resolver.h"
+#include "ExpressionLowering.h"
+
+namespace
+{
+	// Each worker gets a few batches, so uneven function sizes still keep all of them busy
+	constexpr size_t batchesPerThread = 4;
+
+	template<typename Char>
+	std::vector<ParallelParser::Chunk> SplitAtFunctions(const std::basic_string_view<Char> text)
+	{
+		std::vector<ParallelParser::Chunk> chunks;
+		ParallelParser::Chunk chunk;
+		size_t line = 1;
+		size_t depth = 0;
+		// Set when top level closing brace was met, split happens at the end of its line if nothing else follows it
+		bool functionClosed = false;
+		for (size_t i = 0; i < text.size(); ++i)
+		{
+			const Char character = text[i];
+			if (character == Char('#'))
+			{
+				// Comment ends with the newline that is handled below
+				i = std::min(text.find(Char('\n'), i), text.size()) - 1;
+				continue;
+			}
+			if (character == Char('\n'))
+			{
+				++line;
+				if (functionClosed)
+				{
+					chunk.end = i + 1;
+					chunks.push_back(chunk);
+					chunk = { i + 1, 0, Position(line, 1) };
+					functionClosed = false;
+				}
+				continue;
+			}
+			if (character == Char(' ') || (character >= Char('\t') && character <= Char('\r')))
+			{
+				continue;
+			}
+			functionClosed = false;
+			if (character == Char('"'))
+			{
+				// Newlines inside literal do not start new line for the Lexer either
+				for (++i; i < text.size() && text[i] != Char('"'); ++i)
+				{
+					if (text[i] == Char('\\'))
+					{
+						++i;
+					}
+				}
+				if (i >= text.size())
+				{
+					return {};
+				}
+			}
+			else if (character == Char('{'))
+			{
+				++depth;
+			}
+			else if (character == Char('}'))
+			{
+				if (depth == 0)
+				{
+					return {};
+				}
+				functionClosed = --depth == 0;
+			}
+		}
+		if (depth != 0)
+		{
+			return {};
+		}
+		if (chunk.begin != text.size())
+		{
+			chunk.end = text.size();
+			chunks.push_back(chunk);
+		}
+		return chunks;
+	}
+
+	template<typename Char>
+	std::unique_ptr<Program> ParseSequentially(const std::basic_string_view<Char> text)
+	{
+		Lexer lexer(text);
+		const auto tokens = lexer.Tokenize();
+		Parser parser(&tokens);
+		return parser.ParseProgram();
+	}
+}
+
+ParallelParser::ParallelParser(const unsigned int threadCount) noexcept
+	: threadCount(std::max(threadCount, 1u))
+{
+}
+
+std::unique_ptr<Program> ParallelParser::ParseProgram(const std::wstring_view text) const
+{
+	return ParseChunks(text);
+}
+
+std::unique_ptr<Program> ParallelParser::ParseProgram(const std::string_view utf8Text) const
+{
+	return ParseChunks(utf8Text);
+}
+
+std::vector<ParallelParser::Chunk> ParallelParser::Split(const std::wstring_view text)
+{
+	return SplitAtFunctions(text);
+}
+
+std::vector<ParallelParser::Chunk> ParallelParser::Split(const std::string_view utf8Text)
+{
+	return SplitAtFunctions(utf8Text);
+}
+
+template<typename Char>
+std::unique_ptr<Program> ParallelParser::ParseChunks(const std::basic_string_view<Char> text) const
+{
+	if (threadCount == 1)
+	{
+		return ParseSequentially(text);
+	}
+	const auto chunks = Split(text);
+	if (chunks.size() < 2)
+	{
+		return ParseSequentially(text);
+	}
+
+	// Neighbouring chunks are joined into batches of similar size
+	std::vector<Chunk> batches;
+	const size_t batchSize = std::max<size_t>(text.size() / (threadCount * batchesPerThread), 1);
+	for (const auto& chunk : chunks)
+	{
+		if (batches.empty() || batches.back().end - batches.back().begin >= batchSize)
+		{
+			batches.push_back(chunk);
+		}
+		else
+		{
+			batches.back().end = chunk.end;
+		}
+	}
+
+	std::vector<Program> parts(batches.size());
+	std::atomic<size_t> nextBatch = 0;
+	std::atomic<bool> failed = false;
+	const auto parseBatches = [&]()
+	{
+		for (size_t index = nextBatch++; index < batches.size() && !failed; index = nextBatch++)
+		{
+			const auto& batch = batches[index];
+			Lexer lexer(text.substr(batch.begin, batch.end - batch.begin), batch.start);
+			const auto tokens = lexer.Tokenize();
+			if (!tokens.GetErrors().empty())
+			{
+				failed = true;
+				return;
+			}
+			try
+			{
+				ParserImpl(&tokens).ParseFunctionDefinitions(parts[index]);
+			}
+			catch (...)
+			{
+				// Sequential parse on the calling thread reports the error (or throws it) the usual way
+				failed = true;
+				return;
+			}
+		}
+	};
+
+	std::vector<std::thread> workers;
+	const auto workerCount = std::min<size_t>(threadCount, batches.size()) - 1;
+	for (size_t i = 0; i < workerCount; ++i)
+	{
+		workers.emplace_back(parseBatches);
+	}
+	parseBatches();
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+
+	if (failed)
+	{
+		return ParseSequentially(text);
+	}
+	auto program = std::make_unique<Program>();
+	for (auto& part : parts)
+	{
+		program->arena.Adopt(std::move(part.arena));
+		std::move(part.funDefs.begin(), part.funDefs.end(), std::back_inserter(program->funDefs));
+	}
+	Resolver().Resolve(program.get());
+	ExpressionLowering().Lower(program.get());
+	return program;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "Position.h"
+#include "ParserObjects/ParserObjects.h"
+
+// Parses large sources split at top level function definitions, parts are lexed and parsed on worker threads
+// and the definitions are merged back in source order, Positions are the same as in the whole source.
+// Sources with any lexical or syntax error are parsed again sequentially, so errors are reported exactly as Parser reports them.
+class ParallelParser
+{
+public:
+	// Part of the source, begins at the start of a line with its Position in the whole source
+	struct Chunk
+	{
+		size_t begin = 0;
+		size_t end = 0;
+		Position start = Position(1, 1);
+	};
+
+	explicit ParallelParser(const unsigned int threadCount = std::thread::hardware_concurrency()) noexcept;
+
+	// Text has to outlive the parsing only
+	std::unique_ptr<Program> ParseProgram(const std::wstring_view text) const;
+	std::unique_ptr<Program> ParseProgram(const std::string_view utf8Text) const;
+
+	// Source is split after lines in which closing brace returned to the top level, braces in string literals
+	// and comments do not count. Empty when braces do not balance, such source is parsed sequentially.
+	static std::vector<Chunk> Split(const std::wstring_view text);
+	static std::vector<Chunk> Split(const std::string_view utf8Text);
+
+private:
+	template<typename Char>
+	std::unique_ptr<Program> ParseChunks(const std::basic_string_view<Char> text) const;
+
+	unsigned int threadCount;
+};
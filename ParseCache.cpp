@@ -0,0 +1,75 @@
+#include "ParseCache.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <utility>
+#include "ProgramImage.h"
+
+namespace
+{
+	constexpr char statisticsFileName[] = "statistics";
+	constexpr char hitMark = 'h';
+	constexpr char missMark = 'm';
+}
+
+ParseCache::ParseCache(std::filesystem::path directory)
+	: directory(std::move(directory))
+{
+	// Failure shows up as misses and failed stores
+	std::error_code error;
+	std::filesystem::create_directories(this->directory, error);
+}
+
+std::unique_ptr<Program> ParseCache::Load(const std::string_view utf8Text)
+{
+	const auto sourceHash = ProgramImage::HashSource(utf8Text);
+	auto program = ProgramImage::Load(GetImagePath(sourceHash).string(), sourceHash);
+	RecordLookup(program != nullptr);
+	return program;
+}
+
+bool ParseCache::Store(const Program& program, const std::string_view utf8Text) const
+{
+	const auto sourceHash = ProgramImage::HashSource(utf8Text);
+	return ProgramImage::Write(program, sourceHash, GetImagePath(sourceHash).string());
+}
+
+std::filesystem::path ParseCache::GetImagePath(const uint64_t sourceHash) const
+{
+	// Images of other versions are never looked up again, so they can be removed along with the whole directory
+	char name[64];
+	std::snprintf(name, sizeof(name), "%016llx-%u-%u.image", static_cast<unsigned long long>(sourceHash),
+		static_cast<unsigned int>(interpreterVersion), static_cast<unsigned int>(ProgramImage::formatVersion));
+	return directory / name;
+}
+
+ParseCache::Statistics ParseCache::GetStatistics() const noexcept
+{
+	return statistics;
+}
+
+ParseCache::Statistics ParseCache::ReadTotalStatistics() const
+{
+	Statistics totals;
+	std::ifstream file(directory / statisticsFileName, std::ios::binary);
+	for (auto mark = std::istreambuf_iterator<char>(file); mark != std::istreambuf_iterator<char>(); ++mark)
+	{
+		if (*mark == hitMark)
+		{
+			++totals.hits;
+		}
+		else if (*mark == missMark)
+		{
+			++totals.misses;
+		}
+	}
+	return totals;
+}
+
+void ParseCache::RecordLookup(const bool hit)
+{
+	++(hit ? statistics.hits : statistics.misses);
+	// Single byte appended to the file is not torn by processes appending at the same time
+	std::ofstream file(directory / statisticsFileName, std::ios::binary | std::ios::app);
+	file.put(hit ? hitMark : missMark);
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include "ParserObjects/ParserObjects.h"
+
+// Directory of program images named after the hash of the source bytes and the interpreter version, so scripts that
+// were run before are loaded instead of being lexed and parsed. Directory can be shared by processes running at once.
+// Every lookup is appended to the statistics file of the directory, hits and misses of all runs can be read back from it.
+class ParseCache
+{
+public:
+	// Has to be raised whenever the same source is parsed, resolved or lowered differently
+	static constexpr uint32_t interpreterVersion = 1;
+
+	struct Statistics
+	{
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+	};
+
+	// Directory is created when missing
+	explicit ParseCache(std::filesystem::path directory);
+
+	// Returns nullptr on miss, the source has to be parsed and stored then
+	std::unique_ptr<Program> Load(const std::string_view utf8Text);
+	// Program has to be parsed from the text without errors
+	bool Store(const Program& program, const std::string_view utf8Text) const;
+
+	std::filesystem::path GetImagePath(const uint64_t sourceHash) const;
+	// Lookups made through this object
+	Statistics GetStatistics() const noexcept;
+	// Lookups of all runs using the directory
+	Statistics ReadTotalStatistics() const;
+
+private:
+	void RecordLookup(const bool hit);
+
+	std::filesystem::path directory;
+	Statistics statistics;
+};
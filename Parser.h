@@ -8,8 +8,13 @@ public:
 		: ParserImpl(lexer)
 	{
 	}
+	Parser(const TokenBuffer* const tokens)
+		: ParserImpl(tokens)
+	{
+	}
 	std::unique_ptr<Program> ParseProgram()
 	{
 		return ParserImpl::ParseProgram();
 	}
+	using ParserImpl::HadErrors;
 };
\ No newline at end of file
@@ -1,11 +1,22 @@
 #include "ParserImpl.h"
 #include <iostream>
+#include "Resolver.h"
+#include "ExpressionLowering.h"
 
 ParserImpl::ParserImpl(Lexer* const lexer)
 {
 	SetLexer(lexer);
 }
 
+ParserImpl::ParserImpl(const TokenBuffer* const tokens)
+{
+	if (!tokens)
+	{
+		throw std::runtime_error("Passed token buffer was a nullptr");
+	}
+	tokenBuffer = tokens;
+}
+
 void ParserImpl::SetLexer(Lexer* const newLexer)
 {
 	if (!newLexer)
@@ -13,65 +24,143 @@ void ParserImpl::SetLexer(Lexer* const newLexer)
 		throw std::runtime_error("Passed lexer was a nullptr");
 	}
 	lexer = newLexer;
+	tokenBuffer = nullptr;
 }
 
 LexToken ParserImpl::GetTokenFromLexer()
 {
+	if (tokenBuffer)
+	{
+		return GetTokenFromBuffer();
+	}
+
+	// Errors of skipped comments are reported as well, the same as with the token buffer
 	auto lexOut = lexer->ResolveNext();
-	auto& token = lexOut.first;
-	while (token.GetType() == LexToken::TokenType::Comment)
+	for (const auto& lexError : lexOut.second)
+	{
+		ReportLexicalError(lexError);
+	}
+	while (lexOut.first.GetType() == LexToken::TokenType::Comment)
 	{
 		lexOut = lexer->ResolveNext();
-		token = lexOut.first;
+		for (const auto& lexError : lexOut.second)
+		{
+			ReportLexicalError(lexError);
+		}
 	}
-	for (const auto& lexError : lexOut.second)
+
+	return lexOut.first;
+}
+
+LexToken ParserImpl::GetTokenFromBuffer()
+{
+	const auto& errors = tokenBuffer->GetErrors();
+	while (nextTokenIndex < tokenBuffer->GetSize())
 	{
-		std::cout << "Lexical Error [line: " << lexError.GetPosition().line << ", column : " <<
-			lexError.GetPosition().column << "] " << lexError.GetMessage() << std::endl;
-		if (lexError.IsTerminating())
+		const auto index = nextTokenIndex++;
+		for (; nextErrorIndex < errors.size() && errors[nextErrorIndex].tokenIndex == index; ++nextErrorIndex)
 		{
-			throw ParserException("Could not get token, terminating lexer error occured.", currentPosition);
+			ReportLexicalError(errors[nextErrorIndex].error);
 		}
+		if (tokenBuffer->GetType(index) != LexToken::TokenType::Comment)
+		{
+			return tokenBuffer->GetToken(index);
+		}
+	}
+	// Lexer keeps returning end of file once it was reached
+	if (tokenBuffer->IsComplete())
+	{
+		return tokenBuffer->GetToken(tokenBuffer->GetSize() - 1);
 	}
+	throw ParserException("Could not get token, terminating lexer error occured.", currentPosition);
+}
 
-	return token;
+void ParserImpl::ReportLexicalError(const LexicalError& lexError)
+{
+	errorReported = true;
+	std::cout << "Lexical Error [line: " << lexError.GetPosition().line << ", column : " <<
+		lexError.GetPosition().column << "] " << lexError.GetMessage() << std::endl;
+	if (lexError.IsTerminating())
+	{
+		throw ParserException("Could not get token, terminating lexer error occured.", currentPosition);
+	}
 }
 
 LexToken ParserImpl::GetNextToken()
 {
-	if (!lastUnusedToken)
+	// Position follows every token, so it does not depend on what was parsed before (e.g. in another part of the source)
+	if (lookaheadSize == 0)
 	{
-		return GetTokenFromLexer();
+		auto token = GetTokenFromLexer();
+		currentPosition = token.GetPosition();
+		return token;
 	}
-	else
+	auto token = std::move(lookahead[lookaheadFront]);
+	lookaheadFront = (lookaheadFront + 1) & (lookaheadCapacity - 1);
+	--lookaheadSize;
+	currentPosition = token.GetPosition();
+	return token;
+}
+
+const LexToken& ParserImpl::PeekToken(const size_t offset)
+{
+	if (offset >= lookaheadCapacity)
+	{
+		throw std::runtime_error("Peeked token is past the parser lookahead");
+	}
+	for (; lookaheadSize <= offset; ++lookaheadSize)
+	{
+		lookahead[(lookaheadFront + lookaheadSize) & (lookaheadCapacity - 1)] = GetTokenFromLexer();
+	}
+	return lookahead[(lookaheadFront + offset) & (lookaheadCapacity - 1)];
+}
+
+void ParserImpl::SkipToken()
+{
+	currentPosition = PeekToken().GetPosition();
+	lookaheadFront = (lookaheadFront + 1) & (lookaheadCapacity - 1);
+	--lookaheadSize;
+}
+
+void ParserImpl::PushBackToken(LexToken token)
+{
+	if (lookaheadSize == lookaheadCapacity)
 	{
-		const auto out = std::move(*lastUnusedToken);
-		lastUnusedToken = std::nullopt;
-		currentPosition = out.GetPosition();
-		return out;
+		throw std::runtime_error("Parser lookahead is full");
 	}
+	lookaheadFront = (lookaheadFront - 1) & (lookaheadCapacity - 1);
+	lookahead[lookaheadFront] = std::move(token);
+	++lookaheadSize;
 }
 
+// Missed expectations leave the token in place, current position still points at it for error messages
 std::optional<LexToken> ParserImpl::GetExpectedToken(const LexToken::TokenType expectedToken)
 {
-	auto token = GetNextToken();
+	const auto& token = PeekToken();
 	if (token.GetType() != expectedToken)
 	{
-		lastUnusedToken = std::move(token);
+		currentPosition = token.GetPosition();
 		return std::nullopt;
 	}
-	return token;
+	return GetNextToken();
 }
 
 bool ParserImpl::ConsumeToken(const LexToken::TokenType expectedToken)
 {
-	return GetExpectedToken(expectedToken).has_value();
+	if (PeekToken().GetType() != expectedToken)
+	{
+		currentPosition = PeekToken().GetPosition();
+		return false;
+	}
+	SkipToken();
+	return true;
 }
 
 bool ParserImpl::CheckToken(const LexToken::TokenType expectedToken)
 {
-	lastUnusedToken = GetNextToken();
-	return lastUnusedToken->GetType() == expectedToken;
+	const auto& token = PeekToken();
+	currentPosition = token.GetPosition();
+	return token.GetType() == expectedToken;
 }
 
 // program = { function_definition };
@@ -80,23 +169,38 @@ std::unique_ptr<Program> ParserImpl::ParseProgram()
 	auto program = std::make_unique<Program>();
 	try
 	{
-		while (auto funDef = ParseFunctionDefinition())
-		{
-			program->funDefs.push_back(std::move(funDef));
-		}
-		if (!ConsumeToken(LexToken::TokenType::EndOfFile))
-		{
-			throw ParserException("Could not parse next function definition and end of file was not met.", currentPosition);
-		}
+		ParseFunctionDefinitions(*program);
 	}
 	catch (const ParserException& pe)
 	{
+		errorReported = true;
 		std::cout << pe.what();
 	}
 
+	Resolver().Resolve(program.get());
+	ExpressionLowering().Lower(program.get());
 	return program;
 }
 
+bool ParserImpl::HadErrors() const noexcept
+{
+	return errorReported;
+}
+
+void ParserImpl::ParseFunctionDefinitions(Program& program)
+{
+	// Nodes are allocated from the arena of the program they end up in
+	const AstArena::Scope arenaScope(program.arena);
+	while (auto funDef = ParseFunctionDefinition())
+	{
+		program.funDefs.push_back(std::move(funDef));
+	}
+	if (!ConsumeToken(LexToken::TokenType::EndOfFile))
+	{
+		throw ParserException("Could not parse next function definition and end of file was not met.", currentPosition);
+	}
+}
+
 // function_definition = "func", identifier, "(", parameters, ")", block;
 std::unique_ptr<FunctionDefiniton> ParserImpl::ParseFunctionDefinition()
 {
@@ -121,7 +225,7 @@ std::unique_ptr<FunctionDefiniton> ParserImpl::ParseFunctionDefinition()
 
 	auto functionDefinition = std::make_unique<FunctionDefiniton>();
 	functionDefinition->startingPosition = startingPosition;
-	functionDefinition->identifier = std::get<std::wstring>(idToken->GetValue());
+	functionDefinition->identifier = std::get<Symbol>(idToken->GetValue());
 
 	if (!ConsumeToken(LT::LParenth))
 	{
@@ -188,7 +292,7 @@ std::optional<Param> ParserImpl::ParseParam()
 		}
 		return std::nullopt;
 	}
-	param.identifier = std::get<std::wstring>(idToken->GetValue());
+	param.identifier = std::get<Symbol>(idToken->GetValue());
 	return param;
 }
 
@@ -252,7 +356,7 @@ std::unique_ptr<Statement> ParserImpl::ParseStatement()
 	if (idToken)
 	{
 		auto startingPosition = currentPosition;
-		const auto identifier = std::get<std::wstring>(idToken->GetValue());
+		const auto identifier = std::get<Symbol>(idToken->GetValue());
 		if (auto assignment = ParseRestOfAssignment(identifier))
 		{
 			assignment->startingPosition = startingPosition;
@@ -269,7 +373,7 @@ std::unique_ptr<Statement> ParserImpl::ParseStatement()
 }
 
 // function_call_statement = function_call, ";";
-std::unique_ptr<FunctionCallStatement> ParserImpl::ParseRestOfFunctionCallStatement(const std::wstring& identifier)
+std::unique_ptr<FunctionCallStatement> ParserImpl::ParseRestOfFunctionCallStatement(const Symbol identifier)
 {
 	if (auto funcCall = ParseRestOfFunctionCall(identifier))
 	{
@@ -283,7 +387,7 @@ std::unique_ptr<FunctionCallStatement> ParserImpl::ParseRestOfFunctionCallStatem
 	return nullptr;
 }
 
-std::unique_ptr<FunctionCall> ParserImpl::ParseRestOfFunctionCall(const std::wstring& identifier)
+std::unique_ptr<FunctionCall> ParserImpl::ParseRestOfFunctionCall(const Symbol identifier)
 {
 	using LT = LexToken::TokenType;
 
@@ -421,7 +525,7 @@ std::unique_ptr<Declaration> ParserImpl::ParseDeclaration()
 	{
 		throw ParserException("Expected identifier after var keyword.", currentPosition);
 	}
-	declaration->identifier = std::get<std::wstring>(idToken->GetValue());
+	declaration->identifier = std::get<Symbol>(idToken->GetValue());
 
 	if (ConsumeToken(LT::Assign))
 	{
@@ -448,7 +552,7 @@ std::unique_ptr<Declaration> ParserImpl::ParseDeclaration()
 }
 
 // assignment = identifier, "=", expression, ";";
-std::unique_ptr<Assignment> ParserImpl::ParseRestOfAssignment(const std::wstring& identifier)
+std::unique_ptr<Assignment> ParserImpl::ParseRestOfAssignment(const Symbol identifier)
 {
 	using LT = LexToken::TokenType;
 
@@ -518,211 +622,226 @@ std::unique_ptr<Expression> ParserImpl::ParseExpression()
 	return nullptr;
 }
 
-// standard_expression   = conjunction, { "||", conjunction }
-std::unique_ptr<StandardExpression> ParserImpl::ParseStandardExpression()
+namespace
 {
-	auto conjunction = ParseConjunction();
-	if (!conjunction)
-	{
-		return nullptr;
-	}
-	auto startingPosition = conjunction->startingPosition;
-	std::vector<std::unique_ptr<Conjunction>> conjunctions;
-	conjunctions.push_back(std::move(conjunction));
-	while (ConsumeToken(LexToken::TokenType::LogicalOr))
+	using Precedence = ParserImpl::Precedence;
+
+	// Level the binary operator chains, every operator token is classified once instead of being tried at each level
+	std::optional<Precedence> GetPrecedence(const LexToken::TokenType type) noexcept
 	{
-		if (conjunction = ParseConjunction())
+		using LT = LexToken::TokenType;
+		switch (type)
 		{
-			conjunctions.push_back(std::move(conjunction));
-		}
-		else
-		{
-			throw ParserException("Expected expression after \"||\".", currentPosition);
+		case LT::LogicalOr:
+			return Precedence::Or;
+		case LT::LogicalAnd:
+			return Precedence::And;
+		case LT::Less:
+		case LT::LessEqual:
+		case LT::Greater:
+		case LT::GreaterEqual:
+		case LT::Equal:
+		case LT::NotEqual:
+			return Precedence::Relation;
+		case LT::Plus:
+		case LT::Minus:
+			return Precedence::Additive;
+		case LT::Asterisk:
+		case LT::Slash:
+			return Precedence::Multiplicative;
+		default:
+			return std::nullopt;
 		}
 	}
-	auto expr = std::make_unique<StandardExpression>(std::move(conjunctions));
-	expr->startingPosition = startingPosition;
-	return expr;
-}
 
-// conjunction = relation_term, { "&&", relation_term };
-std::unique_ptr<Conjunction> ParserImpl::ParseConjunction()
-{
-	auto relation = ParseRelation();
-	if (!relation)
+	RelationOperator ToRelationOperator(const LexToken::TokenType type) noexcept
 	{
-		return nullptr;
+		using LT = LexToken::TokenType;
+		switch (type)
+		{
+		case LT::Less:
+			return RelationOperator::Less;
+		case LT::LessEqual:
+			return RelationOperator::LessEqual;
+		case LT::Greater:
+			return RelationOperator::Greater;
+		case LT::GreaterEqual:
+			return RelationOperator::GreaterEqual;
+		case LT::Equal:
+			return RelationOperator::Equal;
+		default:
+			return RelationOperator::NotEqual;
+		}
 	}
-	auto conjunction = std::make_unique<Conjunction>();
-	conjunction->startingPosition = relation->startingPosition;
-	conjunction->relations.push_back(std::move(relation));
-	
-	while (ConsumeToken(LexToken::TokenType::LogicalAnd))
+
+	// Moves finished nodes of levels binding tighter than the given one into their parents
+	void CloseLevels(ParserImpl::OpenLevels& levels, const Precedence precedence)
 	{
-		if (relation = ParseRelation())
+		if (precedence < Precedence::Multiplicative)
 		{
-			conjunction->relations.push_back(std::move(relation));
+			levels.additive->multiplicatives.push_back(std::move(levels.multiplicative));
 		}
-		else
+		if (precedence < Precedence::Additive)
 		{
-			throw ParserException("Expected expression after \"&&\".", currentPosition);
+			auto& additive = levels.relation->relationOperator ? levels.relation->secondAdditive : levels.relation->firstAdditive;
+			additive = std::move(levels.additive);
 		}
-	}
-
-	return conjunction;
-}
-
-// relation_term = additive_term, [relation_operator, additive_term];
-std::unique_ptr<Relation> ParserImpl::ParseRelation()
-{
-	using LT = LexToken::TokenType;
-	auto additive = ParseAdditive();
-	if (!additive)
-	{
-		return nullptr;
-	}
-
-	auto relation = std::make_unique<Relation>();
-	relation->startingPosition = additive->startingPosition;
-	relation->firstAdditive = std::move(additive);
-
-	bool isRelationOp = false;
-	if (ConsumeToken(LT::Less))
-	{
-		relation->relationOperator = RelationOperator::Less;
-		isRelationOp = true;
-	}
-	else if (ConsumeToken(LT::LessEqual))
-	{
-		relation->relationOperator = RelationOperator::LessEqual;
-		isRelationOp = true;
-	}
-	else if (ConsumeToken(LT::Greater))
-	{
-		relation->relationOperator = RelationOperator::Greater;
-		isRelationOp = true;
-	}
-	else if (ConsumeToken(LT::GreaterEqual))
-	{
-		relation->relationOperator = RelationOperator::GreaterEqual;
-		isRelationOp = true;
-	}
-	else if (ConsumeToken(LT::Equal))
-	{
-		relation->relationOperator = RelationOperator::Equal;
-		isRelationOp = true;
-	}
-	else if (ConsumeToken(LT::NotEqual))
-	{
-		relation->relationOperator = RelationOperator::NotEqual;
-		isRelationOp = true;
-	}
-	if (isRelationOp)
-	{
-		auto nextAdditive = ParseAdditive();
-		if (!nextAdditive)
+		if (precedence < Precedence::Relation)
 		{
-			throw ParserException("Expected expression after relation operator.", currentPosition);
+			levels.conjunction->relations.push_back(std::move(levels.relation));
+		}
+		if (precedence < Precedence::And)
+		{
+			levels.conjunctions.push_back(std::move(levels.conjunction));
 		}
-		relation->secondAdditive = std::move(nextAdditive);
 	}
-
-	return relation;
 }
 
-// additive_term = ["-"], (multiplicative_term, { ("+" | "-"), multiplicative_term });
-std::unique_ptr<Additive> ParserImpl::ParseAdditive()
+// Precedence climbing over the levels of standard_expression, from the loosest given one down to factors.
+// Node of a level is created once its first factor was parsed, operators of looser levels are left unconsumed.
+bool ParserImpl::ParseOperators(OpenLevels& levels, const Precedence loosest)
 {
 	using LT = LexToken::TokenType;
 
-	auto additive = std::make_unique<Additive>();
-
-	additive->negated = ConsumeToken(LT::Minus);
-	auto startingPosition = currentPosition;
-	auto multiplicative = ParseMultiplicative();
-	if (!multiplicative)
-	{
-		return nullptr;
-	}
-	additive->startingPosition = (additive->negated) ? startingPosition : multiplicative->startingPosition;
-
-	additive->multiplicatives.push_back(std::move(multiplicative));
-
+	const char* missingOperandMessage = nullptr;
 	while (true)
 	{
-		if (ConsumeToken(LT::Plus))
+		// additive_term = ["-"], ...
+		bool negated = false;
+		Position negationPosition = currentPosition;
+		if (loosest <= Precedence::Additive && !levels.additive)
 		{
-			additive->operators.push_back(AdditionOperator::Plus);
+			negated = ConsumeToken(LT::Minus);
+			negationPosition = currentPosition;
 		}
-		else
+
+		auto factor = ParseFactor();
+		if (!factor)
 		{
-			if (ConsumeToken(LT::Minus))
+			if (missingOperandMessage)
 			{
-				additive->operators.push_back(AdditionOperator::Minus);
-			}
-			else
-			{
-				break;
+				throw ParserException(missingOperandMessage, currentPosition);
 			}
+			return false;
+		}
+		if (!levels.multiplicative)
+		{
+			levels.multiplicative = std::make_unique<Multiplicative>();
+			levels.multiplicative->startingPosition = factor->startingPosition;
+		}
+		if (loosest <= Precedence::Additive && !levels.additive)
+		{
+			levels.additive = std::make_unique<Additive>();
+			levels.additive->negated = negated;
+			levels.additive->startingPosition = negated ? negationPosition : factor->startingPosition;
+		}
+		if (loosest <= Precedence::Relation && !levels.relation)
+		{
+			levels.relation = std::make_unique<Relation>();
+			levels.relation->startingPosition = levels.additive->startingPosition;
+		}
+		if (loosest <= Precedence::And && !levels.conjunction)
+		{
+			levels.conjunction = std::make_unique<Conjunction>();
+			levels.conjunction->startingPosition = levels.relation->startingPosition;
 		}
+		levels.multiplicative->factors.push_back(std::move(factor));
 
-		if (multiplicative = ParseMultiplicative())
+		const auto type = PeekToken().GetType();
+		const auto precedence = GetPrecedence(type);
+		// relation_term has at most one relation operator
+		if (!precedence || *precedence < loosest || (*precedence == Precedence::Relation && levels.relation->relationOperator))
 		{
-			additive->multiplicatives.push_back(std::move(multiplicative));
+			currentPosition = PeekToken().GetPosition();
+			return true;
 		}
-		else
+		SkipToken();
+
+		CloseLevels(levels, *precedence);
+		switch (*precedence)
 		{
-			throw ParserException("Expected expression after addition operator.", currentPosition);
+		case Precedence::Multiplicative:
+			levels.multiplicative->operators.push_back(type == LT::Asterisk ? MultiplicationOperator::Multiply : MultiplicationOperator::Divide);
+			missingOperandMessage = "Expected expression after muliplication operator.";
+			break;
+		case Precedence::Additive:
+			levels.additive->operators.push_back(type == LT::Plus ? AdditionOperator::Plus : AdditionOperator::Minus);
+			missingOperandMessage = "Expected expression after addition operator.";
+			break;
+		case Precedence::Relation:
+			levels.relation->relationOperator = ToRelationOperator(type);
+			missingOperandMessage = "Expected expression after relation operator.";
+			break;
+		case Precedence::And:
+			missingOperandMessage = "Expected expression after \"&&\".";
+			break;
+		case Precedence::Or:
+			missingOperandMessage = "Expected expression after \"||\".";
+			break;
 		}
 	}
-
-	return additive;
 }
 
-// multiplicative_term = factor, { ("*" | "/"), factor };
-std::unique_ptr<Multiplicative> ParserImpl::ParseMultiplicative()
+// standard_expression   = conjunction, { "||", conjunction }
+std::unique_ptr<StandardExpression> ParserImpl::ParseStandardExpression()
 {
-	using LT = LexToken::TokenType;
-
-	auto factor = ParseFactor();
-	if (!factor)
+	OpenLevels levels;
+	if (!ParseOperators(levels, Precedence::Or))
 	{
 		return nullptr;
 	}
+	CloseLevels(levels, Precedence::Or);
+	const auto startingPosition = levels.conjunctions.front()->startingPosition;
+	auto expr = std::make_unique<StandardExpression>(std::move(levels.conjunctions));
+	expr->startingPosition = startingPosition;
+	return expr;
+}
 
-	auto multiplicative = std::make_unique<Multiplicative>();
-	multiplicative->startingPosition = factor->startingPosition;
-	multiplicative->factors.push_back(std::move(factor));
+// conjunction = relation_term, { "&&", relation_term };
+std::unique_ptr<Conjunction> ParserImpl::ParseConjunction()
+{
+	OpenLevels levels;
+	if (!ParseOperators(levels, Precedence::And))
+	{
+		return nullptr;
+	}
+	CloseLevels(levels, Precedence::And);
+	return std::move(levels.conjunction);
+}
 
-	while (true)
+// relation_term = additive_term, [relation_operator, additive_term];
+std::unique_ptr<Relation> ParserImpl::ParseRelation()
+{
+	OpenLevels levels;
+	if (!ParseOperators(levels, Precedence::Relation))
 	{
-		if (ConsumeToken(LT::Asterisk))
-		{
-			multiplicative->operators.push_back(MultiplicationOperator::Multiply);
-		}
-		else
-		{
-			if (ConsumeToken(LT::Slash))
-			{
-				multiplicative->operators.push_back(MultiplicationOperator::Divide);
-			}
-			else
-			{
-				break;
-			}
-		}
+		return nullptr;
+	}
+	CloseLevels(levels, Precedence::Relation);
+	return std::move(levels.relation);
+}
 
-		if (factor = ParseFactor())
-		{
-			multiplicative->factors.push_back(std::move(factor));
-		}
-		else
-		{
-			throw ParserException("Expected expression after muliplication operator.", currentPosition);
-		}
+// additive_term = ["-"], (multiplicative_term, { ("+" | "-"), multiplicative_term });
+std::unique_ptr<Additive> ParserImpl::ParseAdditive()
+{
+	OpenLevels levels;
+	if (!ParseOperators(levels, Precedence::Additive))
+	{
+		return nullptr;
 	}
+	CloseLevels(levels, Precedence::Additive);
+	return std::move(levels.additive);
+}
 
-	return multiplicative;
+// multiplicative_term = factor, { ("*" | "/"), factor };
+std::unique_ptr<Multiplicative> ParserImpl::ParseMultiplicative()
+{
+	OpenLevels levels;
+	if (!ParseOperators(levels, Precedence::Multiplicative))
+	{
+		return nullptr;
+	}
+	return std::move(levels.multiplicative);
 }
 
 // factor = ["!"], (literal | "(", standard_expression, ")" | identifier | function_call);
@@ -730,22 +849,19 @@ std::unique_ptr<Factor> ParserImpl::ParseFactor()
 {
 	using LT = LexToken::TokenType;
 
-	auto factor = std::make_unique<Factor>();
-	factor->logicallyNegated = ConsumeToken(LT::LogicalNot);
-	auto startingPosition = currentPosition;
-
-	if (auto literal = ParseLiteral())
-	{
-		factor->startingPosition = (factor->logicallyNegated) ? startingPosition : literal->startingPosition;
-		factor->factor = std::move(*literal);
-		return factor;
-	}
+	const bool logicallyNegated = ConsumeToken(LT::LogicalNot);
+	const auto startingPosition = currentPosition;
 
 	if (ConsumeToken(LT::LParenth))
 	{
 		auto expression = ParseStandardExpression();
-		factor->startingPosition = (factor->logicallyNegated) ? startingPosition : expression->startingPosition;
-		factor->factor = std::move(expression);
+		if (!expression)
+		{
+			throw ParserException("Expected expression after opening parentheses.", currentPosition);
+		}
+		const auto expressionPosition = expression->startingPosition;
+		auto factor = std::make_unique<Factor>(std::move(expression), logicallyNegated);
+		factor->startingPosition = logicallyNegated ? startingPosition : expressionPosition;
 		if (!ConsumeToken(LT::RParenth))
 		{
 			throw ParserException("Expected closing parentheses after expression", currentPosition);
@@ -753,24 +869,32 @@ std::unique_ptr<Factor> ParserImpl::ParseFactor()
 		return factor;
 	}
 
-	auto idToken = GetExpectedToken(LT::Identifier);
-	if (idToken)
+	if (const auto token = GetExpectedToken(LT::Identifier))
 	{
-		factor->startingPosition = (factor->logicallyNegated) ? startingPosition : currentPosition;
-		const auto identifier = std::get<std::wstring>(idToken->GetValue());
+		const auto identifierPosition = currentPosition;
+		const auto identifier = std::get<Symbol>(token->GetValue());
+		auto factor = std::make_unique<Factor>();
+		factor->logicallyNegated = logicallyNegated;
+		factor->startingPosition = logicallyNegated ? startingPosition : identifierPosition;
 		if (auto functionCall = ParseRestOfFunctionCall(identifier))
 		{
 			factor->factor = std::move(functionCall);
-			return factor;
 		}
 		else
 		{
 			factor->factor = identifier;
-			return factor;
 		}
+		return factor;
+	}
+
+	if (auto literal = ParseLiteral())
+	{
+		auto factor = std::make_unique<Factor>(*literal, logicallyNegated);
+		factor->startingPosition = logicallyNegated ? startingPosition : literal->startingPosition;
+		return factor;
 	}
 
-	if (factor->logicallyNegated)
+	if (logicallyNegated)
 	{
 		throw ParserException("Expected expression after logical negation.", currentPosition);
 	}
@@ -783,27 +907,28 @@ std::optional<Literal> ParserImpl::ParseLiteral()
 {
 	using LT = LexToken::TokenType;
 
-	if (const auto integer = GetExpectedToken(LT::Integer))
-	{
-		return Literal(std::get<int>(integer->GetValue()), currentPosition);
-	}
-
-	if (const auto floatNumber = GetExpectedToken(LT::Float))
-	{
-		return Literal(std::get<float>(floatNumber->GetValue()), currentPosition);
-	}
-
-	if (const auto string = GetExpectedToken(LT::String))
-	{
-		return Literal(std::get<std::wstring>(string->GetValue()), currentPosition);
-	}
-	;
-	if (const auto boolean = GetExpectedToken(LT::Boolean))
-	{
-		return Literal(std::get<bool>(boolean->GetValue()), currentPosition);
+	const auto& token = PeekToken();
+	std::optional<Literal> literal;
+	switch (token.GetType())
+	{
+	case LT::Integer:
+		literal = Literal(std::get<int>(token.GetValue()), token.GetPosition());
+		break;
+	case LT::Float:
+		literal = Literal(std::get<float>(token.GetValue()), token.GetPosition());
+		break;
+	case LT::String:
+		literal = Literal(std::wstring(token.GetText()), token.GetPosition());
+		break;
+	case LT::Boolean:
+		literal = Literal(std::get<bool>(token.GetValue()), token.GetPosition());
+		break;
+	default:
+		currentPosition = token.GetPosition();
+		return std::nullopt;
 	}
-
-	return std::nullopt;
+	SkipToken();
+	return literal;
 }
 
 // func_expression = composable, { ">>", composable };
@@ -871,8 +996,9 @@ std::unique_ptr<Bindable> ParserImpl::ParseBindable()
 {
 	using LT = LexToken::TokenType;
 
-	if (auto funcLit = ParseFunctionLit())
+	if (IsFunctionLiteralAhead())
 	{
+		auto funcLit = ParseFunctionLit();
 		auto startingPosition = funcLit->startingPosition;
 		auto bindable = std::make_unique<Bindable>(std::move(funcLit));
 		bindable->startingPosition = startingPosition;
@@ -883,7 +1009,7 @@ std::unique_ptr<Bindable> ParserImpl::ParseBindable()
 	if (idToken)
 	{
 		auto startingPosition = currentPosition;
-		const auto identifier = std::get<std::wstring>(idToken->GetValue());
+		const auto identifier = std::get<Symbol>(idToken->GetValue());
 		if (auto functionCall = ParseRestOfFunctionCall(identifier))
 		{
 			auto bindable = std::make_unique<Bindable>(std::move(functionCall));
@@ -903,13 +1029,13 @@ std::unique_ptr<Bindable> ParserImpl::ParseBindable()
 		return nullptr;
 	}
 	auto funcExpr = ParseFuncExpression();
-	auto startingPositon = funcExpr->startingPosition;
-	auto bindable = std::make_unique<Bindable>(std::move(funcExpr));
-	bindable->startingPosition = startingPositon;
-	if (!bindable)
+	if (!funcExpr)
 	{
 		throw ParserException("Expected function expression after opening parentheses.", currentPosition);
 	}
+	auto startingPositon = funcExpr->startingPosition;
+	auto bindable = std::make_unique<Bindable>(std::move(funcExpr));
+	bindable->startingPosition = startingPositon;
 
 	if (!ConsumeToken(LT::RParenth))
 	{
@@ -919,6 +1045,28 @@ std::unique_ptr<Bindable> ParserImpl::ParseBindable()
 	return bindable;
 }
 
+// Both function_lit and parenthesized func_expression start with "(", parameters are told apart by the tokens after it:
+// "()", "(mut", "(identifier," and "(identifier) {" can not start function expression
+bool ParserImpl::IsFunctionLiteralAhead()
+{
+	using LT = LexToken::TokenType;
+
+	if (PeekToken().GetType() != LT::LParenth)
+	{
+		return false;
+	}
+	switch (PeekToken(1).GetType())
+	{
+	case LT::RParenth:
+	case LT::Mut:
+		return true;
+	case LT::Identifier:
+		return PeekToken(2).GetType() == LT::Comma || (PeekToken(2).GetType() == LT::RParenth && PeekToken(3).GetType() == LT::LBracket);
+	default:
+		return false;
+	}
+}
+
 // function_lit = "(", parameters, ")", block;
 std::unique_ptr<FunctionLiteral> ParserImpl::ParseFunctionLit()
 {
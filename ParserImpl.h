@@ -1,6 +1,8 @@
 #pragma once
+#include <array>
 #include <istream>
 #include "Lexer.h"
+#include "TokenBuffer.h"
 #include "ParserObjects/ParserObjects.h"
 #include <queue>
 #include <sstream>
@@ -28,14 +30,48 @@ public:
 		}
 	};
 
+	// Levels of standard_expression, from the loosest binding operator
+	enum class Precedence : uint8_t
+	{
+		Or,
+		And,
+		Relation,
+		Additive,
+		Multiplicative
+	};
+
+	// Unfinished node of every level while operators are parsed, levels looser than the parsed one stay empty
+	struct OpenLevels
+	{
+		std::vector<std::unique_ptr<Conjunction>> conjunctions;
+		std::unique_ptr<Conjunction> conjunction;
+		std::unique_ptr<Relation> relation;
+		std::unique_ptr<Additive> additive;
+		std::unique_ptr<Multiplicative> multiplicative;
+	};
+
 	ParserImpl(Lexer* const lexer);
+	// Tokens are read from the buffer by index instead of being lexed on demand, buffer has to outlive the parser
+	ParserImpl(const TokenBuffer* const tokens);
 	void SetLexer(Lexer* const newLexer);
 
 	std::unique_ptr<Program> ParseProgram();
+	// Parses definitions up to the end of file without resolving them, throws ParserException on syntax error
+	void ParseFunctionDefinitions(Program& program);
+	// Whether lexical or syntax error was printed while parsing
+	bool HadErrors() const noexcept;
 
 	//private:
 	LexToken GetTokenFromLexer();
+	LexToken GetTokenFromBuffer();
+	// Prints the error, throws ParserException when lexer can not continue
+	void ReportLexicalError(const LexicalError& lexError);
 	LexToken GetNextToken();
+	// Token the given number of places after the next one, read from the source and kept until it is consumed
+	const LexToken& PeekToken(const size_t offset = 0);
+	void SkipToken();
+	// Makes the token the next one again
+	void PushBackToken(LexToken token);
 	std::optional<LexToken> GetExpectedToken(const LexToken::TokenType expectedToken);
 	bool ConsumeToken(const LexToken::TokenType expectedToken);
 	bool CheckToken(const LexToken::TokenType expectedToken);
@@ -50,12 +86,13 @@ public:
 	std::unique_ptr<WhileLoop> ParseLoop();
 	std::unique_ptr<Return> ParseReturn();
 	std::unique_ptr<Declaration> ParseDeclaration();
-	std::unique_ptr<Assignment> ParseRestOfAssignment(const std::wstring& identifier);
+	std::unique_ptr<Assignment> ParseRestOfAssignment(const Symbol identifier);
 	std::vector<std::unique_ptr<Expression>> ParseArguments();
-	std::unique_ptr<FunctionCallStatement> ParseRestOfFunctionCallStatement(const std::wstring& identifier);
-	std::unique_ptr<FunctionCall> ParseRestOfFunctionCall(const std::wstring& identifier);
+	std::unique_ptr<FunctionCallStatement> ParseRestOfFunctionCallStatement(const Symbol identifier);
+	std::unique_ptr<FunctionCall> ParseRestOfFunctionCall(const Symbol identifier);
 
 	std::unique_ptr<Expression> ParseExpression();
+	bool ParseOperators(OpenLevels& levels, const Precedence loosest);
 	std::unique_ptr<StandardExpression> ParseStandardExpression();
 	std::unique_ptr<Conjunction> ParseConjunction();
 	std::unique_ptr<Relation> ParseRelation();
@@ -67,10 +104,23 @@ public:
 	std::unique_ptr<FuncExpression> ParseFuncExpression();
 	std::unique_ptr<Composable> ParseComposable();
 	std::unique_ptr<Bindable> ParseBindable();
+	bool IsFunctionLiteralAhead();
 	std::unique_ptr<FunctionLiteral> ParseFunctionLit();
 
 	//private:
-	std::optional<LexToken> lastUnusedToken;
+	// Ring of tokens read ahead, lookaheadSize of them starting at lookaheadFront
+	static constexpr size_t lookaheadCapacity = 4;
+	static_assert((lookaheadCapacity & (lookaheadCapacity - 1)) == 0, "Ring index is masked");
+	std::array<LexToken, lookaheadCapacity> lookahead = {
+		LexToken(LexToken::TokenType::EndOfFile, Position(0, 0)), LexToken(LexToken::TokenType::EndOfFile, Position(0, 0)),
+		LexToken(LexToken::TokenType::EndOfFile, Position(0, 0)), LexToken(LexToken::TokenType::EndOfFile, Position(0, 0))
+	};
+	size_t lookaheadFront = 0;
+	size_t lookaheadSize = 0;
 	Lexer* lexer = nullptr;
+	const TokenBuffer* tokenBuffer = nullptr;
+	size_t nextTokenIndex = 0;
+	size_t nextErrorIndex = 0;
 	Position currentPosition = Position(0, 0);
+	bool errorReported = false;
 };
\ No newline at end of file
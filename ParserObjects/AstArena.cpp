@@ -0,0 +1,128 @@
+#include "AstArena.h"
+#include <algorithm>
+#include <iterator>
+#include <new>
+#include <utility>
+
+thread_local AstArena* AstArena::current = nullptr;
+
+namespace
+{
+	enum class NodeOrigin : unsigned char
+	{
+		Heap,
+		Arena
+	};
+}
+
+AstArena::Scope::Scope(AstArena& arena) noexcept
+	: previous(current)
+{
+	current = &arena;
+}
+
+AstArena::Scope::~Scope()
+{
+	current = previous;
+}
+
+AstArena::AstArena(AstArena&& other) noexcept
+	: blocks(std::move(other.blocks)),
+	next(std::exchange(other.next, nullptr)),
+	blockEnd(std::exchange(other.blockEnd, nullptr)),
+	nodeCount(std::exchange(other.nodeCount, 0)),
+	byteCount(std::exchange(other.byteCount, 0)),
+	reservedByteCount(std::exchange(other.reservedByteCount, 0))
+{
+}
+
+AstArena& AstArena::operator=(AstArena&& other) noexcept
+{
+	if (&other != this)
+	{
+		blocks = std::move(other.blocks);
+		next = std::exchange(other.next, nullptr);
+		blockEnd = std::exchange(other.blockEnd, nullptr);
+		nodeCount = std::exchange(other.nodeCount, 0);
+		byteCount = std::exchange(other.byteCount, 0);
+		reservedByteCount = std::exchange(other.reservedByteCount, 0);
+	}
+	return *this;
+}
+
+void AstArena::Adopt(AstArena&& other)
+{
+	if (&other == this)
+	{
+		return;
+	}
+	// Current block stays the one to bump from, adopted ones are only kept alive
+	std::move(other.blocks.begin(), other.blocks.end(), std::back_inserter(blocks));
+	nodeCount += other.nodeCount;
+	byteCount += other.byteCount;
+	reservedByteCount += other.reservedByteCount;
+	other = AstArena();
+}
+
+size_t AstArena::GetNodeCount() const noexcept
+{
+	return nodeCount;
+}
+
+size_t AstArena::GetByteCount() const noexcept
+{
+	return byteCount;
+}
+
+size_t AstArena::GetReservedByteCount() const noexcept
+{
+	return reservedByteCount;
+}
+
+void* AstArena::AllocateNode(const size_t size)
+{
+	std::byte* header;
+	if (current)
+	{
+		header = static_cast<std::byte*>(current->Allocate(headerSize + size));
+		*reinterpret_cast<NodeOrigin*>(header) = NodeOrigin::Arena;
+	}
+	else
+	{
+		header = static_cast<std::byte*>(::operator new(headerSize + size));
+		*reinterpret_cast<NodeOrigin*>(header) = NodeOrigin::Heap;
+	}
+	return header + headerSize;
+}
+
+void AstArena::FreeNode(void* const node) noexcept
+{
+	if (!node)
+	{
+		return;
+	}
+	std::byte* const header = static_cast<std::byte*>(node) - headerSize;
+	if (*reinterpret_cast<const NodeOrigin*>(header) == NodeOrigin::Heap)
+	{
+		::operator delete(header);
+	}
+}
+
+void* AstArena::Allocate(const size_t size)
+{
+	const size_t alignedSize = (size + headerSize - 1) / headerSize * headerSize;
+	if (static_cast<size_t>(blockEnd - next) < alignedSize)
+	{
+		const size_t newBlockSize = std::max(blockSize, alignedSize);
+		// Left uninitialized, every node is constructed in place anyway
+		blocks.emplace_back(new std::byte[newBlockSize]);
+		next = blocks.back().get();
+		blockEnd = next + newBlockSize;
+		reservedByteCount += newBlockSize;
+	}
+	void* const memory = next;
+	next += alignedSize;
+	++nodeCount;
+	byteCount += alignedSize;
+	return memory;
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Bump allocator for the nodes of one Program, memory of all of them is freed at once with the arena.
+// Nodes allocated while a Scope is active on the thread come from its arena, all other (e.g. built by hand in tests) from the heap.
+// Node destructors still run as usual, deleting a node from the arena only leaves its memory for the arena to free.
+class AstArena
+{
+public:
+	class Scope
+	{
+	public:
+		explicit Scope(AstArena& arena) noexcept;
+		~Scope();
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		AstArena* previous;
+	};
+
+	AstArena() = default;
+	AstArena(AstArena&& other) noexcept;
+	AstArena& operator=(AstArena&& other) noexcept;
+
+	// Takes over memory of the other arena, e.g. when nodes of several Programs are merged into one
+	void Adopt(AstArena&& other);
+
+	size_t GetNodeCount() const noexcept;
+	// Bytes handed out to nodes, including the per node header
+	size_t GetByteCount() const noexcept;
+	// Bytes allocated from the heap for the blocks
+	size_t GetReservedByteCount() const noexcept;
+
+	static void* AllocateNode(const size_t size);
+	static void FreeNode(void* const node) noexcept;
+
+private:
+	void* Allocate(const size_t size);
+
+	// Every node is preceded by a header telling whether it came from an arena
+	static constexpr size_t headerSize = alignof(std::max_align_t);
+	static constexpr size_t blockSize = 64 * 1024;
+
+	std::vector<std::unique_ptr<std::byte[]>> blocks;
+	std::byte* next = nullptr;
+	std::byte* blockEnd = nullptr;
+	size_t nodeCount = 0;
+	size_t byteCount = 0;
+	size_t reservedByteCount = 0;
+
+	static thread_local AstArena* current;
+};
+
+// Declares allocation of the node through AstArena, derived nodes inherit it
+#define AST_NODE_ALLOCATION \
+	static void* operator new(const size_t size) { return AstArena::AllocateNode(size); } \
+	static void operator delete(void* const node) noexcept { AstArena::FreeNode(node); }
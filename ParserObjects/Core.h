@@ -3,20 +3,23 @@
 #include <memory>
 #include <vector>
 #include "../Position.h"
+#include "../Symbol.h"
+#include "AstArena.h"
 
 struct Param
 {
 	Param() = default;
-	Param(const std::wstring& identifier, bool paramMutable = false) noexcept :
+	Param(const Symbol identifier, bool paramMutable = false) noexcept :
 		identifier(identifier), paramMutable(paramMutable) {}
 	bool paramMutable = false;
-	std::wstring identifier;
+	Symbol identifier;
 	Position startingPosition = Position(0, 0);
 };
 
 struct FunctionDefiniton
 {
-	std::wstring identifier;
+	AST_NODE_ALLOCATION
+	Symbol identifier;
 	std::vector<Param> parameters;
 	std::unique_ptr<struct Block> block;
 	Position startingPosition = Position(0, 0);
@@ -24,5 +27,7 @@ struct FunctionDefiniton
 
 struct Program
 {
+	// Declared first, so the nodes are destroyed before their memory is freed
+	AstArena arena;
 	std::vector<std::unique_ptr<FunctionDefiniton>> funDefs;
 };
\ No newline at end of file
@@ -4,18 +4,31 @@
 #include<string>
 #include<optional>
 #include<vector>
+#include<cstdint>
 #include "../Position.h"
+#include "../Symbol.h"
+#include "../StringData.h"
+#include "AstArena.h"
 
 class Interpreter;
 struct FuncExpression;
 struct StandardExpression;
 struct FunctionCall;
+struct FunctionDefiniton;
 struct Param;
 struct Block;
 class Value;
 
+// Variable location found by Resolver: number of scopes to go up and index of the variable in that scope
+struct VariableSlot
+{
+	unsigned int depth = 0;
+	unsigned int slot = 0;
+};
+
 struct Expression
 {
+	AST_NODE_ALLOCATION
 	virtual ~Expression() = default;
 	virtual Value EvaluateThis(Interpreter& interpreter) const = 0;
 	Position startingPosition = Position(0, 0);
@@ -25,6 +38,9 @@ struct Literal
 {
 	std::variant<bool, int, float, std::wstring> value;
 	Position startingPosition = Position(0, 0);
+	// Set by ExpressionLowering for string literals, equal literals of the program share the payload.
+	// Null for literals built by hand, those are evaluated into a new string every time.
+	RefPtr<StringData> interned = {};
 };
 
 enum class MultiplicationOperator
@@ -35,6 +51,7 @@ enum class MultiplicationOperator
 
 struct Factor
 {
+	AST_NODE_ALLOCATION
 	Factor() = default;
 
 	Factor(const Literal& literal, bool logicallyNegated = false)
@@ -49,17 +66,19 @@ struct Factor
 		: factor(std::move(functionCall)), logicallyNegated(logicallyNegated) {
 	}
 
-	Factor(const std::wstring& string, bool logicallyNegated = false)
-		: factor(string), logicallyNegated(logicallyNegated) {
+	Factor(const Symbol identifier, bool logicallyNegated = false)
+		: factor(identifier), logicallyNegated(logicallyNegated) {
 	}
 
 	bool logicallyNegated = false;
-	std::variant<std::wstring, Literal, std::unique_ptr<StandardExpression>, std::unique_ptr<FunctionCall>> factor;
+	std::variant<Symbol, Literal, std::unique_ptr<StandardExpression>, std::unique_ptr<FunctionCall>> factor;
+	std::optional<VariableSlot> variableSlot;
 	Position startingPosition = Position(0, 0);
 };
 
 struct Multiplicative
 {
+	AST_NODE_ALLOCATION
 	Multiplicative() = default;
 	Multiplicative(std::vector<std::unique_ptr<Factor>> factors, std::vector<MultiplicationOperator> operators = {}) :
 		factors(std::move(factors)), operators(operators) {
@@ -77,6 +96,7 @@ enum class AdditionOperator
 
 struct Additive
 {
+	AST_NODE_ALLOCATION
 	Additive() = default;
 	Additive(std::vector<std::unique_ptr<Multiplicative>> multiplicatives, std::vector<AdditionOperator> operators = {}, const bool negated = false) :
 		multiplicatives(std::move(multiplicatives)), operators(operators), negated(negated) {
@@ -99,6 +119,7 @@ enum class RelationOperator
 
 struct Relation
 {
+	AST_NODE_ALLOCATION
 	Relation() = default;
 	Relation(std::unique_ptr<Additive> firstAdditive, const std::optional<RelationOperator>& relationOperator = std::nullopt, std::unique_ptr<Additive> secondAdditive = nullptr) noexcept :
 		firstAdditive(std::move(firstAdditive)), relationOperator(relationOperator), secondAdditive(std::move(secondAdditive)) {
@@ -111,6 +132,7 @@ struct Relation
 
 struct Conjunction
 {
+	AST_NODE_ALLOCATION
 	Conjunction() = default;
 	Conjunction(std::vector<std::unique_ptr<Relation>> relations) noexcept :
 		relations(std::move(relations)) {
@@ -119,6 +141,37 @@ struct Conjunction
 	Position startingPosition = Position(0, 0);
 };
 
+// Node of StandardExpression lowered by ExpressionLowering. Levels of the cascade with a single child are left out,
+// operator chains become left associative binary nodes and factors stay leaves evaluated as before
+struct ExpressionNode
+{
+	enum class Kind : uint8_t
+	{
+		Literal,
+		Factor,
+		Or,
+		And,
+		Equal,
+		NotEqual,
+		Greater,
+		GreaterEqual,
+		Less,
+		LessEqual,
+		Add,
+		Subtract,
+		Multiply,
+		Divide,
+		Negate,
+		LogicalNot
+	};
+
+	Kind kind = Kind::Factor;
+	uint32_t left = 0;
+	uint32_t right = 0;
+	const Literal* literal = nullptr;
+	const Factor* factor = nullptr;
+};
+
 struct StandardExpression : Expression
 {
 	StandardExpression() = default;
@@ -126,11 +179,15 @@ struct StandardExpression : Expression
 		conjunctions(std::move(conjunctions)) {
 	}
 	std::vector<std::unique_ptr<Conjunction>> conjunctions;
+	// Set by ExpressionLowering, operands precede their operators and the root is the last node.
+	// Empty when expression was not lowered (e.g. built by hand), then the cascade is evaluated.
+	std::vector<ExpressionNode> lowered;
 	virtual Value EvaluateThis(Interpreter& interpreter) const override;
 };
 
 struct FunctionLiteral
 {
+	AST_NODE_ALLOCATION
 	std::vector<Param> parameters;
 	std::unique_ptr<Block> block;
 	Position startingPosition = Position(0, 0);
@@ -138,6 +195,7 @@ struct FunctionLiteral
 
 struct Bindable
 {
+	AST_NODE_ALLOCATION
 	Bindable(std::unique_ptr<FunctionLiteral> bindable) :
 		bindable(std::move(bindable)) {
 	}
@@ -147,15 +205,18 @@ struct Bindable
 	Bindable(std::unique_ptr<FunctionCall> bindable) :
 		bindable(std::move(bindable)) {
 	}
-	Bindable(const std::wstring& bindable) :
+	Bindable(const Symbol bindable) :
 		bindable(bindable) {
 	}
-	std::variant<std::unique_ptr<FunctionLiteral>, std::unique_ptr<FuncExpression>, std::unique_ptr<FunctionCall>, std::wstring> bindable;
+	std::variant<std::unique_ptr<FunctionLiteral>, std::unique_ptr<FuncExpression>, std::unique_ptr<FunctionCall>, Symbol> bindable;
+	std::optional<VariableSlot> variableSlot;
+	const FunctionDefiniton* functionDefinition = nullptr;
 	Position startingPosition = Position(0, 0);
 };
 
 struct Composable
 {
+	AST_NODE_ALLOCATION
 	std::unique_ptr<Bindable> bindable;
 	std::vector<std::unique_ptr<Expression>> arguments;
 	Position startingPosition = Position(0, 0);
@@ -8,6 +8,7 @@ class Interpreter;
 
 struct Statement
 {
+	AST_NODE_ALLOCATION
 	virtual ~Statement() = default;
 	virtual void InterpretThis(Interpreter& interpreter) const = 0;
 	Position startingPosition = Position(0, 0);
@@ -24,11 +25,14 @@ struct Block : Statement
 
 struct FunctionCall
 {
-	FunctionCall(const std::wstring& identifier, std::vector<std::unique_ptr<Expression>> arguments = {}) noexcept :
+	AST_NODE_ALLOCATION
+	FunctionCall(const Symbol identifier, std::vector<std::unique_ptr<Expression>> arguments = {}) noexcept :
 		identifier(identifier), arguments(std::move(arguments)) {
 	}
-	std::wstring identifier;
+	Symbol identifier;
 	std::vector<std::unique_ptr<Expression>> arguments;
+	std::optional<VariableSlot> variableSlot;
+	const FunctionDefiniton* functionDefinition = nullptr;
 	Position startingPosition = Position(0, 0);
 };
 
@@ -68,18 +72,23 @@ struct Return : Statement
 struct Declaration : Statement
 {
 	bool varMutable = false;
-	std::wstring identifier;
+	Symbol identifier;
 	std::unique_ptr<Expression> expression;
+	// Set when Resolver proved the declaration is neither a redefinition nor a function name
+	std::optional<VariableSlot> variableSlot;
 	virtual void InterpretThis(Interpreter& interpreter) const override;
 };
 
 struct Assignment : Statement
 {
-	Assignment(const std::wstring& identifier, std::unique_ptr<Expression> expression) noexcept :
+	Assignment(const Symbol identifier, std::unique_ptr<Expression> expression) noexcept :
 		identifier(identifier), expression(std::move(expression)) {
 	}
 
-	std::wstring identifier;
+	Symbol identifier;
 	std::unique_ptr<Expression> expression;
+	std::optional<VariableSlot> variableSlot;
+	// Set by Resolver when expression is `identifier + ...`, so the Interpreter can append to the variable in place
+	const Additive* selfAppend = nullptr;
 	virtual void InterpretThis(Interpreter& interpreter) const override;
 };
\ No newline at end of file
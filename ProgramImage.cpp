@@ -0,0 +1,952 @@
+#include "ProgramImage.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+#include "MappedFile.h"
+#include "Resolver.h"
+#include "ExpressionLowering.h"
+
+namespace
+{
+	constexpr char imageMagic[4] = { 'I', 'P', 'R', 'G' };
+
+	struct ImageHeader
+	{
+		char magic[4];
+		uint16_t formatVersion;
+		uint8_t characterSize;
+		uint8_t reserved;
+		uint32_t stringCount;
+		uint32_t characterCount;
+		uint32_t nodesSize;
+		uint32_t padding;
+		uint64_t sourceHash;
+		// Hash of everything after the header
+		uint64_t contentHash;
+	};
+	static_assert(sizeof(ImageHeader) == 40, "Header size is part of the format");
+
+	// Offset and length in characters of the string in the characters section
+	struct StringEntry
+	{
+		uint32_t offset;
+		uint32_t length;
+	};
+
+	enum class StatementTag : uint8_t
+	{
+		Block,
+		FunctionCall,
+		Conditional,
+		WhileLoop,
+		Return,
+		Declaration,
+		Assignment
+	};
+
+	enum class ExpressionTag : uint8_t
+	{
+		Standard,
+		Func
+	};
+
+	// Thrown on truncated or malformed node stream, the image is then rejected as a whole
+	class ImageError : public std::runtime_error
+	{
+	public:
+		ImageError() : std::runtime_error("Malformed program image")
+		{
+		}
+	};
+
+	class ImageWriter
+	{
+	public:
+		void WriteProgram(const Program& program)
+		{
+			WriteNumber(program.funDefs.size());
+			for (const auto& funDef : program.funDefs)
+			{
+				WriteString(funDef->identifier.GetName());
+				WritePosition(funDef->startingPosition);
+				WriteParams(funDef->parameters);
+				WriteBlock(funDef->block.get());
+			}
+		}
+
+		std::vector<uint8_t> Finish(const uint64_t sourceHash) const
+		{
+			ImageHeader header{};
+			std::memcpy(header.magic, imageMagic, sizeof(imageMagic));
+			header.formatVersion = ProgramImage::formatVersion;
+			header.characterSize = sizeof(wchar_t);
+			header.stringCount = static_cast<uint32_t>(strings.size());
+			header.nodesSize = static_cast<uint32_t>(nodes.size());
+			header.sourceHash = sourceHash;
+
+			std::vector<StringEntry> entries;
+			entries.reserve(strings.size());
+			uint32_t characterCount = 0;
+			for (const auto string : strings)
+			{
+				entries.push_back({ characterCount, static_cast<uint32_t>(string.size()) });
+				characterCount += static_cast<uint32_t>(string.size());
+			}
+			header.characterCount = characterCount;
+
+			const size_t entriesSize = entries.size() * sizeof(StringEntry);
+			const size_t charactersSize = size_t(characterCount) * sizeof(wchar_t);
+			std::vector<uint8_t> image(sizeof(ImageHeader) + entriesSize + charactersSize + nodes.size());
+			auto* output = image.data() + sizeof(ImageHeader);
+			if (entriesSize > 0)
+			{
+				std::memcpy(output, entries.data(), entriesSize);
+				output += entriesSize;
+			}
+			for (const auto string : strings)
+			{
+				if (!string.empty())
+				{
+					std::memcpy(output, string.data(), string.size() * sizeof(wchar_t));
+					output += string.size() * sizeof(wchar_t);
+				}
+			}
+			if (!nodes.empty())
+			{
+				std::memcpy(output, nodes.data(), nodes.size());
+			}
+			header.contentHash = ProgramImage::Hash(image.data() + sizeof(ImageHeader), image.size() - sizeof(ImageHeader));
+			std::memcpy(image.data(), &header, sizeof(header));
+			return image;
+		}
+
+	private:
+		void WriteByte(const uint8_t value)
+		{
+			nodes.push_back(value);
+		}
+
+		// LEB128, most numbers in the tree (positions, counts, indices) fit in one or two bytes
+		void WriteNumber(uint64_t value)
+		{
+			while (value >= 0x80)
+			{
+				nodes.push_back(static_cast<uint8_t>(value | 0x80));
+				value >>= 7;
+			}
+			nodes.push_back(static_cast<uint8_t>(value));
+		}
+
+		void WriteSignedNumber(const int64_t value)
+		{
+			WriteNumber((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+		}
+
+		void WriteFloat(const float value)
+		{
+			uint8_t bytes[sizeof(float)];
+			std::memcpy(bytes, &value, sizeof(float));
+			nodes.insert(nodes.end(), bytes, bytes + sizeof(float));
+		}
+
+		void WriteString(const std::wstring_view string)
+		{
+			const auto [found, inserted] = stringIndices.try_emplace(string, static_cast<uint32_t>(strings.size()));
+			if (inserted)
+			{
+				strings.push_back(string);
+			}
+			WriteNumber(found->second);
+		}
+
+		void WritePosition(const Position& position)
+		{
+			WriteNumber(position.line);
+			WriteNumber(position.column);
+		}
+
+		void WriteParams(const std::vector<Param>& parameters)
+		{
+			WriteNumber(parameters.size());
+			for (const auto& param : parameters)
+			{
+				WriteByte(param.paramMutable);
+				WriteString(param.identifier.GetName());
+				WritePosition(param.startingPosition);
+			}
+		}
+
+		void WriteBlock(const Block* const block)
+		{
+			WritePosition(block->startingPosition);
+			WriteNumber(block->statements.size());
+			for (const auto& statement : block->statements)
+			{
+				WriteStatement(statement.get());
+			}
+		}
+
+		void WriteStatement(const Statement* const statement)
+		{
+			if (const auto block = dynamic_cast<const Block*>(statement))
+			{
+				WriteByte(static_cast<uint8_t>(StatementTag::Block));
+				WriteBlock(block);
+				return;
+			}
+			if (const auto functionCallStatement = dynamic_cast<const FunctionCallStatement*>(statement))
+			{
+				WriteByte(static_cast<uint8_t>(StatementTag::FunctionCall));
+				WritePosition(statement->startingPosition);
+				WriteFunctionCall(functionCallStatement->funcCall.get());
+			}
+			else if (const auto conditional = dynamic_cast<const Conditional*>(statement))
+			{
+				WriteByte(static_cast<uint8_t>(StatementTag::Conditional));
+				WritePosition(statement->startingPosition);
+				WriteStandardExpression(conditional->condition.get());
+				WriteBlock(conditional->ifBlock.get());
+				WriteByte(conditional->elseBlock != nullptr);
+				if (conditional->elseBlock)
+				{
+					WriteBlock(conditional->elseBlock.get());
+				}
+			}
+			else if (const auto whileLoop = dynamic_cast<const WhileLoop*>(statement))
+			{
+				WriteByte(static_cast<uint8_t>(StatementTag::WhileLoop));
+				WritePosition(statement->startingPosition);
+				WriteStandardExpression(whileLoop->condition.get());
+				WriteBlock(whileLoop->block.get());
+			}
+			else if (const auto returnStatement = dynamic_cast<const Return*>(statement))
+			{
+				WriteByte(static_cast<uint8_t>(StatementTag::Return));
+				WritePosition(statement->startingPosition);
+				WriteOptionalExpression(returnStatement->expression.get());
+			}
+			else if (const auto declaration = dynamic_cast<const Declaration*>(statement))
+			{
+				WriteByte(static_cast<uint8_t>(StatementTag::Declaration));
+				WritePosition(statement->startingPosition);
+				WriteByte(declaration->varMutable);
+				WriteString(declaration->identifier.GetName());
+				WriteOptionalExpression(declaration->expression.get());
+			}
+			else if (const auto assignment = dynamic_cast<const Assignment*>(statement))
+			{
+				WriteByte(static_cast<uint8_t>(StatementTag::Assignment));
+				WritePosition(statement->startingPosition);
+				WriteString(assignment->identifier.GetName());
+				WriteExpression(assignment->expression.get());
+			}
+			else
+			{
+				throw std::runtime_error("Unknown statement can not be written to program image");
+			}
+		}
+
+		void WriteFunctionCall(const FunctionCall* const functionCall)
+		{
+			WriteString(functionCall->identifier.GetName());
+			WritePosition(functionCall->startingPosition);
+			WriteArguments(functionCall->arguments);
+		}
+
+		void WriteArguments(const std::vector<std::unique_ptr<Expression>>& arguments)
+		{
+			WriteNumber(arguments.size());
+			for (const auto& argument : arguments)
+			{
+				WriteExpression(argument.get());
+			}
+		}
+
+		void WriteOptionalExpression(const Expression* const expression)
+		{
+			WriteByte(expression != nullptr);
+			if (expression)
+			{
+				WriteExpression(expression);
+			}
+		}
+
+		void WriteExpression(const Expression* const expression)
+		{
+			if (const auto standardExpression = dynamic_cast<const StandardExpression*>(expression))
+			{
+				WriteByte(static_cast<uint8_t>(ExpressionTag::Standard));
+				WriteStandardExpression(standardExpression);
+			}
+			else if (const auto funcExpression = dynamic_cast<const FuncExpression*>(expression))
+			{
+				WriteByte(static_cast<uint8_t>(ExpressionTag::Func));
+				WriteFuncExpression(funcExpression);
+			}
+			else
+			{
+				throw std::runtime_error("Unknown expression can not be written to program image");
+			}
+		}
+
+		void WriteStandardExpression(const StandardExpression* const expression)
+		{
+			WritePosition(expression->startingPosition);
+			WriteNumber(expression->conjunctions.size());
+			for (const auto& conjunction : expression->conjunctions)
+			{
+				WritePosition(conjunction->startingPosition);
+				WriteNumber(conjunction->relations.size());
+				for (const auto& relation : conjunction->relations)
+				{
+					WritePosition(relation->startingPosition);
+					WriteAdditive(relation->firstAdditive.get());
+					// Zero when there is no relation operator
+					WriteByte(relation->relationOperator ? static_cast<uint8_t>(*relation->relationOperator) + 1 : 0);
+					if (relation->relationOperator)
+					{
+						WriteAdditive(relation->secondAdditive.get());
+					}
+				}
+			}
+		}
+
+		void WriteAdditive(const Additive* const additive)
+		{
+			WritePosition(additive->startingPosition);
+			WriteByte(additive->negated);
+			WriteNumber(additive->multiplicatives.size());
+			for (size_t i = 0; i < additive->multiplicatives.size(); ++i)
+			{
+				if (i > 0)
+				{
+					WriteByte(static_cast<uint8_t>(additive->operators[i - 1]));
+				}
+				const auto& multiplicative = additive->multiplicatives[i];
+				WritePosition(multiplicative->startingPosition);
+				WriteNumber(multiplicative->factors.size());
+				for (size_t j = 0; j < multiplicative->factors.size(); ++j)
+				{
+					if (j > 0)
+					{
+						WriteByte(static_cast<uint8_t>(multiplicative->operators[j - 1]));
+					}
+					WriteFactor(multiplicative->factors[j].get());
+				}
+			}
+		}
+
+		// Variant alternatives are tagged by their index, reordering them requires new format version
+		void WriteFactor(const Factor* const factor)
+		{
+			WritePosition(factor->startingPosition);
+			WriteByte(factor->logicallyNegated);
+			WriteByte(static_cast<uint8_t>(factor->factor.index()));
+			if (const auto identifier = std::get_if<Symbol>(&factor->factor))
+			{
+				WriteString(identifier->GetName());
+			}
+			else if (const auto literal = std::get_if<Literal>(&factor->factor))
+			{
+				WriteLiteral(*literal);
+			}
+			else if (const auto expression = std::get_if<std::unique_ptr<StandardExpression>>(&factor->factor))
+			{
+				WriteStandardExpression(expression->get());
+			}
+			else
+			{
+				WriteFunctionCall(std::get<std::unique_ptr<FunctionCall>>(factor->factor).get());
+			}
+		}
+
+		void WriteLiteral(const Literal& literal)
+		{
+			WritePosition(literal.startingPosition);
+			WriteByte(static_cast<uint8_t>(literal.value.index()));
+			if (const auto boolean = std::get_if<bool>(&literal.value))
+			{
+				WriteByte(*boolean);
+			}
+			else if (const auto integer = std::get_if<int>(&literal.value))
+			{
+				WriteSignedNumber(*integer);
+			}
+			else if (const auto floatNumber = std::get_if<float>(&literal.value))
+			{
+				WriteFloat(*floatNumber);
+			}
+			else
+			{
+				WriteString(std::get<std::wstring>(literal.value));
+			}
+		}
+
+		void WriteFuncExpression(const FuncExpression* const funcExpression)
+		{
+			WritePosition(funcExpression->startingPosition);
+			WriteNumber(funcExpression->composables.size());
+			for (const auto& composable : funcExpression->composables)
+			{
+				WritePosition(composable->startingPosition);
+				WriteBindable(composable->bindable.get());
+				WriteArguments(composable->arguments);
+			}
+		}
+
+		void WriteBindable(const Bindable* const bindable)
+		{
+			WritePosition(bindable->startingPosition);
+			WriteByte(static_cast<uint8_t>(bindable->bindable.index()));
+			if (const auto functionLiteral = std::get_if<std::unique_ptr<FunctionLiteral>>(&bindable->bindable))
+			{
+				WritePosition((*functionLiteral)->startingPosition);
+				WriteParams((*functionLiteral)->parameters);
+				WriteBlock((*functionLiteral)->block.get());
+			}
+			else if (const auto funcExpression = std::get_if<std::unique_ptr<FuncExpression>>(&bindable->bindable))
+			{
+				WriteFuncExpression(funcExpression->get());
+			}
+			else if (const auto functionCall = std::get_if<std::unique_ptr<FunctionCall>>(&bindable->bindable))
+			{
+				WriteFunctionCall(functionCall->get());
+			}
+			else
+			{
+				WriteString(std::get<Symbol>(bindable->bindable).GetName());
+			}
+		}
+
+		std::vector<uint8_t> nodes;
+		// Views of names and literals of the written program, it outlives the writer
+		std::vector<std::wstring_view> strings;
+		std::unordered_map<std::wstring_view, uint32_t> stringIndices;
+	};
+
+	class ImageReader
+	{
+	public:
+		ImageReader(const uint8_t* const nodes, const size_t size, std::vector<std::wstring_view> strings)
+			: data(nodes), end(nodes + size), strings(std::move(strings)), symbols(this->strings.size())
+		{
+		}
+
+		void ReadProgram(Program& program)
+		{
+			const auto count = ReadCount();
+			for (size_t i = 0; i < count; ++i)
+			{
+				auto funDef = std::make_unique<FunctionDefiniton>();
+				funDef->identifier = ReadSymbol();
+				funDef->startingPosition = ReadPosition();
+				funDef->parameters = ReadParams();
+				funDef->block = ReadBlock();
+				program.funDefs.push_back(std::move(funDef));
+			}
+			if (data != end)
+			{
+				throw ImageError();
+			}
+		}
+
+	private:
+		uint8_t ReadByte()
+		{
+			if (data == end)
+			{
+				throw ImageError();
+			}
+			return *data++;
+		}
+
+		bool ReadBool()
+		{
+			const auto value = ReadByte();
+			if (value > 1)
+			{
+				throw ImageError();
+			}
+			return value == 1;
+		}
+
+		uint64_t ReadNumber()
+		{
+			uint64_t value = 0;
+			for (unsigned int shift = 0; shift < 64; shift += 7)
+			{
+				const auto byte = ReadByte();
+				value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+				if ((byte & 0x80) == 0)
+				{
+					return value;
+				}
+			}
+			throw ImageError();
+		}
+
+		// Every counted element takes at least one byte, so larger counts can only come from a damaged image
+		size_t ReadCount()
+		{
+			const auto count = ReadNumber();
+			if (count > static_cast<uint64_t>(end - data))
+			{
+				throw ImageError();
+			}
+			return static_cast<size_t>(count);
+		}
+
+		int ReadInteger()
+		{
+			const auto encoded = ReadNumber();
+			return static_cast<int>(static_cast<int64_t>(encoded >> 1) ^ -static_cast<int64_t>(encoded & 1));
+		}
+
+		float ReadFloat()
+		{
+			if (end - data < static_cast<std::ptrdiff_t>(sizeof(float)))
+			{
+				throw ImageError();
+			}
+			float value;
+			std::memcpy(&value, data, sizeof(float));
+			data += sizeof(float);
+			return value;
+		}
+
+		std::wstring_view ReadString()
+		{
+			const auto index = ReadNumber();
+			if (index >= strings.size())
+			{
+				throw ImageError();
+			}
+			return strings[index];
+		}
+
+		// Each name is interned once, further uses only copy the Symbol
+		Symbol ReadSymbol()
+		{
+			const auto index = ReadNumber();
+			if (index >= strings.size())
+			{
+				throw ImageError();
+			}
+			auto& symbol = symbols[index];
+			if (symbol.IsEmpty())
+			{
+				symbol = Symbol(strings[index]);
+			}
+			return symbol;
+		}
+
+		Position ReadPosition()
+		{
+			const auto line = ReadNumber();
+			return Position(line, ReadNumber());
+		}
+
+		template<typename Enum>
+		Enum ReadEnum(const Enum last)
+		{
+			const auto value = ReadByte();
+			if (value > static_cast<uint8_t>(last))
+			{
+				throw ImageError();
+			}
+			return static_cast<Enum>(value);
+		}
+
+		std::vector<Param> ReadParams()
+		{
+			std::vector<Param> parameters(ReadCount());
+			for (auto& param : parameters)
+			{
+				param.paramMutable = ReadBool();
+				param.identifier = ReadSymbol();
+				param.startingPosition = ReadPosition();
+			}
+			return parameters;
+		}
+
+		std::unique_ptr<Block> ReadBlock()
+		{
+			auto block = std::make_unique<Block>();
+			block->startingPosition = ReadPosition();
+			const auto count = ReadCount();
+			block->statements.reserve(count);
+			for (size_t i = 0; i < count; ++i)
+			{
+				block->statements.push_back(ReadStatement());
+			}
+			return block;
+		}
+
+		std::unique_ptr<Statement> ReadStatement()
+		{
+			const auto tag = ReadEnum(StatementTag::Assignment);
+			if (tag == StatementTag::Block)
+			{
+				return ReadBlock();
+			}
+			const auto position = ReadPosition();
+			std::unique_ptr<Statement> statement;
+			switch (tag)
+			{
+			case StatementTag::FunctionCall:
+				statement = std::make_unique<FunctionCallStatement>(ReadFunctionCall());
+				break;
+			case StatementTag::Conditional:
+			{
+				auto conditional = std::make_unique<Conditional>();
+				conditional->condition = ReadStandardExpression();
+				conditional->ifBlock = ReadBlock();
+				if (ReadBool())
+				{
+					conditional->elseBlock = ReadBlock();
+				}
+				statement = std::move(conditional);
+				break;
+			}
+			case StatementTag::WhileLoop:
+			{
+				auto whileLoop = std::make_unique<WhileLoop>();
+				whileLoop->condition = ReadStandardExpression();
+				whileLoop->block = ReadBlock();
+				statement = std::move(whileLoop);
+				break;
+			}
+			case StatementTag::Return:
+				statement = std::make_unique<Return>(ReadOptionalExpression());
+				break;
+			case StatementTag::Declaration:
+			{
+				auto declaration = std::make_unique<Declaration>();
+				declaration->varMutable = ReadBool();
+				declaration->identifier = ReadSymbol();
+				declaration->expression = ReadOptionalExpression();
+				statement = std::move(declaration);
+				break;
+			}
+			default:
+			{
+				const auto identifier = ReadSymbol();
+				statement = std::make_unique<Assignment>(identifier, ReadExpression());
+				break;
+			}
+			}
+			statement->startingPosition = position;
+			return statement;
+		}
+
+		std::unique_ptr<FunctionCall> ReadFunctionCall()
+		{
+			const auto identifier = ReadSymbol();
+			const auto position = ReadPosition();
+			auto functionCall = std::make_unique<FunctionCall>(identifier, ReadArguments());
+			functionCall->startingPosition = position;
+			return functionCall;
+		}
+
+		std::vector<std::unique_ptr<Expression>> ReadArguments()
+		{
+			std::vector<std::unique_ptr<Expression>> arguments(ReadCount());
+			for (auto& argument : arguments)
+			{
+				argument = ReadExpression();
+			}
+			return arguments;
+		}
+
+		std::unique_ptr<Expression> ReadOptionalExpression()
+		{
+			return ReadBool() ? ReadExpression() : nullptr;
+		}
+
+		std::unique_ptr<Expression> ReadExpression()
+		{
+			if (ReadEnum(ExpressionTag::Func) == ExpressionTag::Standard)
+			{
+				return ReadStandardExpression();
+			}
+			return ReadFuncExpression();
+		}
+
+		std::unique_ptr<StandardExpression> ReadStandardExpression()
+		{
+			auto expression = std::make_unique<StandardExpression>();
+			expression->startingPosition = ReadPosition();
+			expression->conjunctions.resize(ReadCount());
+			for (auto& conjunction : expression->conjunctions)
+			{
+				conjunction = std::make_unique<Conjunction>();
+				conjunction->startingPosition = ReadPosition();
+				conjunction->relations.resize(ReadCount());
+				for (auto& relation : conjunction->relations)
+				{
+					relation = std::make_unique<Relation>();
+					relation->startingPosition = ReadPosition();
+					relation->firstAdditive = ReadAdditive();
+					const auto relationOperator = ReadByte();
+					if (relationOperator > static_cast<uint8_t>(RelationOperator::LessEqual) + 1)
+					{
+						throw ImageError();
+					}
+					if (relationOperator != 0)
+					{
+						relation->relationOperator = static_cast<RelationOperator>(relationOperator - 1);
+						relation->secondAdditive = ReadAdditive();
+					}
+				}
+			}
+			return expression;
+		}
+
+		std::unique_ptr<Additive> ReadAdditive()
+		{
+			auto additive = std::make_unique<Additive>();
+			additive->startingPosition = ReadPosition();
+			additive->negated = ReadBool();
+			additive->multiplicatives.resize(ReadCount());
+			for (size_t i = 0; i < additive->multiplicatives.size(); ++i)
+			{
+				if (i > 0)
+				{
+					additive->operators.push_back(ReadEnum(AdditionOperator::Minus));
+				}
+				auto& multiplicative = additive->multiplicatives[i];
+				multiplicative = std::make_unique<Multiplicative>();
+				multiplicative->startingPosition = ReadPosition();
+				multiplicative->factors.resize(ReadCount());
+				for (size_t j = 0; j < multiplicative->factors.size(); ++j)
+				{
+					if (j > 0)
+					{
+						multiplicative->operators.push_back(ReadEnum(MultiplicationOperator::Divide));
+					}
+					multiplicative->factors[j] = ReadFactor();
+				}
+			}
+			return additive;
+		}
+
+		std::unique_ptr<Factor> ReadFactor()
+		{
+			auto factor = std::make_unique<Factor>();
+			factor->startingPosition = ReadPosition();
+			factor->logicallyNegated = ReadBool();
+			switch (ReadByte())
+			{
+			case 0:
+				factor->factor = ReadSymbol();
+				break;
+			case 1:
+				factor->factor = ReadLiteral();
+				break;
+			case 2:
+				factor->factor = ReadStandardExpression();
+				break;
+			case 3:
+				factor->factor = ReadFunctionCall();
+				break;
+			default:
+				throw ImageError();
+			}
+			return factor;
+		}
+
+		Literal ReadLiteral()
+		{
+			Literal literal;
+			literal.startingPosition = ReadPosition();
+			switch (ReadByte())
+			{
+			case 0:
+				literal.value = ReadBool();
+				break;
+			case 1:
+				literal.value = ReadInteger();
+				break;
+			case 2:
+				literal.value = ReadFloat();
+				break;
+			case 3:
+				literal.value = std::wstring(ReadString());
+				break;
+			default:
+				throw ImageError();
+			}
+			return literal;
+		}
+
+		std::unique_ptr<FuncExpression> ReadFuncExpression()
+		{
+			auto funcExpression = std::make_unique<FuncExpression>();
+			funcExpression->startingPosition = ReadPosition();
+			funcExpression->composables.resize(ReadCount());
+			for (auto& composable : funcExpression->composables)
+			{
+				composable = std::make_unique<Composable>();
+				composable->startingPosition = ReadPosition();
+				composable->bindable = ReadBindable();
+				composable->arguments = ReadArguments();
+			}
+			return funcExpression;
+		}
+
+		std::unique_ptr<Bindable> ReadBindable()
+		{
+			const auto position = ReadPosition();
+			std::unique_ptr<Bindable> bindable;
+			switch (ReadByte())
+			{
+			case 0:
+			{
+				auto functionLiteral = std::make_unique<FunctionLiteral>();
+				functionLiteral->startingPosition = ReadPosition();
+				functionLiteral->parameters = ReadParams();
+				functionLiteral->block = ReadBlock();
+				bindable = std::make_unique<Bindable>(std::move(functionLiteral));
+				break;
+			}
+			case 1:
+				bindable = std::make_unique<Bindable>(ReadFuncExpression());
+				break;
+			case 2:
+				bindable = std::make_unique<Bindable>(ReadFunctionCall());
+				break;
+			case 3:
+				bindable = std::make_unique<Bindable>(ReadSymbol());
+				break;
+			default:
+				throw ImageError();
+			}
+			bindable->startingPosition = position;
+			return bindable;
+		}
+
+		const uint8_t* data;
+		const uint8_t* const end;
+		// Views into the image, which outlives the reader
+		const std::vector<std::wstring_view> strings;
+		std::vector<Symbol> symbols;
+	};
+}
+
+uint64_t ProgramImage::Hash(const void* const data, const size_t size) noexcept
+{
+	uint64_t hash = 0xCBF29CE484222325ull;
+	const auto* bytes = static_cast<const uint8_t*>(data);
+	for (size_t i = 0; i < size; ++i)
+	{
+		hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+	}
+	return hash;
+}
+
+uint64_t ProgramImage::HashSource(const std::string_view utf8Text) noexcept
+{
+	return Hash(utf8Text.data(), utf8Text.size());
+}
+
+uint64_t ProgramImage::HashSource(const std::wstring_view text) noexcept
+{
+	return Hash(text.data(), text.size() * sizeof(wchar_t));
+}
+
+std::vector<uint8_t> ProgramImage::Serialize(const Program& program, const uint64_t sourceHash)
+{
+	ImageWriter writer;
+	writer.WriteProgram(program);
+	return writer.Finish(sourceHash);
+}
+
+std::unique_ptr<Program> ProgramImage::Deserialize(const uint8_t* const data, const size_t size, const uint64_t sourceHash)
+{
+	if (size < sizeof(ImageHeader) || reinterpret_cast<uintptr_t>(data) % alignof(wchar_t) != 0)
+	{
+		return nullptr;
+	}
+	ImageHeader header;
+	std::memcpy(&header, data, sizeof(header));
+	if (std::memcmp(header.magic, imageMagic, sizeof(imageMagic)) != 0 || header.formatVersion != formatVersion
+		|| header.characterSize != sizeof(wchar_t) || header.sourceHash != sourceHash)
+	{
+		return nullptr;
+	}
+	const uint64_t entriesSize = uint64_t(header.stringCount) * sizeof(StringEntry);
+	const uint64_t charactersSize = uint64_t(header.characterCount) * sizeof(wchar_t);
+	if (sizeof(ImageHeader) + entriesSize + charactersSize + header.nodesSize != size
+		|| Hash(data + sizeof(ImageHeader), size - sizeof(ImageHeader)) != header.contentHash)
+	{
+		return nullptr;
+	}
+
+	// Names and literals are viewed in place, header and entries keep the characters aligned
+	const auto* const characters = reinterpret_cast<const wchar_t*>(data + sizeof(ImageHeader) + entriesSize);
+	std::vector<std::wstring_view> strings;
+	strings.reserve(header.stringCount);
+	for (uint32_t i = 0; i < header.stringCount; ++i)
+	{
+		StringEntry entry;
+		std::memcpy(&entry, data + sizeof(ImageHeader) + i * sizeof(StringEntry), sizeof(entry));
+		if (uint64_t(entry.offset) + entry.length > header.characterCount)
+		{
+			return nullptr;
+		}
+		strings.emplace_back(characters + entry.offset, entry.length);
+	}
+
+	auto program = std::make_unique<Program>();
+	try
+	{
+		// Nodes are allocated from the arena of the program as when it is parsed
+		const AstArena::Scope arenaScope(program->arena);
+		ImageReader reader(data + size - header.nodesSize, header.nodesSize, std::move(strings));
+		reader.ReadProgram(*program);
+	}
+	catch (const ImageError&)
+	{
+		return nullptr;
+	}
+	Resolver().Resolve(program.get());
+	ExpressionLowering().Lower(program.get());
+	return program;
+}
+
+bool ProgramImage::Write(const Program& program, const uint64_t sourceHash, const std::string& path)
+{
+	const auto image = Serialize(program, sourceHash);
+	// Processes sharing a cache may write the same image at once, each one writes its own file
+	const auto temporaryPath = path + "." + std::to_string(std::random_device()()) + ".tmp";
+	std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+	file.write(reinterpret_cast<const char*>(image.data()), image.size());
+	// Data may only reach the disk when the file is closed (e.g. when the disk is full)
+	file.close();
+	std::error_code error;
+	if (!file.fail())
+	{
+		std::filesystem::rename(temporaryPath, path, error);
+		if (!error)
+		{
+			return true;
+		}
+	}
+	// Unfinished files would pile up in directories shared by many runs
+	std::filesystem::remove(temporaryPath, error);
+	return false;
+}
+
+std::unique_ptr<Program> ProgramImage::Load(const std::string& path, const uint64_t sourceHash)
+{
+	MappedFile file;
+	if (!file.Open(path))
+	{
+		return nullptr;
+	}
+	const auto image = file.GetText();
+	return Deserialize(reinterpret_cast<const uint8_t*>(image.data()), image.size(), sourceHash);
+}
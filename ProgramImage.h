@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ParserObjects/ParserObjects.h"
+
+// Compact binary form of a parsed Program, written once and loaded instead of lexing and parsing the source again.
+// Nodes are stored in preorder and refer to names and string literals by index into the string table of the image,
+// so the image holds no pointers and is read straight from the memory mapped file.
+// Header carries format version and hash of the source, images of other version, other source or damaged ones are rejected.
+class ProgramImage
+{
+public:
+	// Has to be raised whenever the layout of the image or of the nodes changes
+	static constexpr uint16_t formatVersion = 1;
+
+	// FNV-1a, used for sources and for the content of images
+	static uint64_t Hash(const void* const data, const size_t size) noexcept;
+	static uint64_t HashSource(const std::string_view utf8Text) noexcept;
+	static uint64_t HashSource(const std::wstring_view text) noexcept;
+
+	// Program has to be parsed without errors, the Resolver annotations are not stored
+	static std::vector<uint8_t> Serialize(const Program& program, const uint64_t sourceHash);
+	// Returns nullptr when image is not valid for the source, loaded program is resolved and lowered as parsed one.
+	// Data has to be aligned for wchar_t, which buffers from the allocator and memory mappings are.
+	static std::unique_ptr<Program> Deserialize(const uint8_t* const data, const size_t size, const uint64_t sourceHash);
+
+	// File is written next to the path under unique name and renamed over it, so readers never see partially written image
+	static bool Write(const Program& program, const uint64_t sourceHash, const std::string& path);
+	static std::unique_ptr<Program> Load(const std::string& path, const uint64_t sourceHash);
+};
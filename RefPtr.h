@@ -0,0 +1,98 @@
+#pragma once
+#include <utility>
+
+// Single pointer, non atomic reference counted handle.
+// Counter is stored next to the object so that handle fits into one machine word.
+template<typename T>
+class RefPtr
+{
+private:
+	struct Box
+	{
+		template<typename... Args>
+		Box(Args&&... args) :
+			object(std::forward<Args>(args)...)
+		{
+		}
+		T object;
+		unsigned int refCount = 1;
+	};
+
+public:
+	RefPtr() noexcept = default;
+
+	template<typename... Args>
+	static RefPtr Make(Args&&... args)
+	{
+		RefPtr ptr;
+		ptr.box = new Box(std::forward<Args>(args)...);
+		return ptr;
+	}
+
+	RefPtr(const RefPtr& other) noexcept :
+		box(other.box)
+	{
+		if (box)
+		{
+			++box->refCount;
+		}
+	}
+
+	RefPtr(RefPtr&& other) noexcept :
+		box(std::exchange(other.box, nullptr))
+	{
+	}
+
+	RefPtr& operator=(const RefPtr& other) noexcept
+	{
+		RefPtr(other).Swap(*this);
+		return *this;
+	}
+
+	RefPtr& operator=(RefPtr&& other) noexcept
+	{
+		RefPtr(std::move(other)).Swap(*this);
+		return *this;
+	}
+
+	~RefPtr()
+	{
+		if (box && --box->refCount == 0)
+		{
+			delete box;
+		}
+	}
+
+	void Swap(RefPtr& other) noexcept
+	{
+		std::swap(box, other.box);
+	}
+
+	T* Get() const noexcept
+	{
+		return box ? &box->object : nullptr;
+	}
+
+	T& operator*() const noexcept
+	{
+		return box->object;
+	}
+
+	T* operator->() const noexcept
+	{
+		return &box->object;
+	}
+
+	explicit operator bool() const noexcept
+	{
+		return box != nullptr;
+	}
+
+	bool IsUnique() const noexcept
+	{
+		return box && box->refCount == 1;
+	}
+
+private:
+	Box* box = nullptr;
+};
@@ -0,0 +1,258 @@
+#include "Resolver.h"
+
+void Resolver::Resolve(Program* const program)
+{
+	functions.clear();
+	for (const auto& funDef : program->funDefs)
+	{
+		functions.emplace(funDef->identifier, funDef.get());
+	}
+	for (const auto& funDef : program->funDefs)
+	{
+		ResolveFunction(funDef->parameters, funDef->block.get());
+	}
+}
+
+void Resolver::ResolveFunction(const std::vector<Param>& parameters, Block* const block)
+{
+	// Function is called in fresh scope without access to the caller's variables
+	auto enclosingScopes = std::move(scopes);
+	scopes.clear();
+	scopes.emplace_back();
+	for (const auto& param : parameters)
+	{
+		scopes.back().push_back(param.identifier);
+	}
+	ResolveBlock(block);
+	scopes = std::move(enclosingScopes);
+}
+
+void Resolver::ResolveBlock(Block* const block)
+{
+	if (!block)
+	{
+		return;
+	}
+	scopes.emplace_back();
+	for (const auto& statement : block->statements)
+	{
+		ResolveStatement(statement.get());
+		if (dynamic_cast<Return*>(statement.get()))
+		{
+			break;
+		}
+	}
+	scopes.pop_back();
+}
+
+void Resolver::ResolveStatement(Statement* const statement)
+{
+	if (auto block = dynamic_cast<Block*>(statement))
+	{
+		ResolveBlock(block);
+	}
+	else if (auto functionCallStatement = dynamic_cast<FunctionCallStatement*>(statement))
+	{
+		ResolveFunctionCall(functionCallStatement->funcCall.get());
+	}
+	else if (auto whileLoop = dynamic_cast<WhileLoop*>(statement))
+	{
+		ResolveStandardExpression(whileLoop->condition.get());
+		ResolveBlock(whileLoop->block.get());
+	}
+	else if (auto returnStatement = dynamic_cast<Return*>(statement))
+	{
+		ResolveExpression(returnStatement->expression.get());
+	}
+	else if (auto conditional = dynamic_cast<Conditional*>(statement))
+	{
+		ResolveStandardExpression(conditional->condition.get());
+		ResolveBlock(conditional->ifBlock.get());
+		ResolveBlock(conditional->elseBlock.get());
+	}
+	else if (auto declaration = dynamic_cast<Declaration*>(statement))
+	{
+		ResolveDeclaration(declaration);
+	}
+	else if (auto assignment = dynamic_cast<Assignment*>(statement))
+	{
+		assignment->variableSlot = FindVariable(assignment->identifier);
+		assignment->selfAppend = FindSelfAppend(assignment);
+		ResolveExpression(assignment->expression.get());
+	}
+}
+
+void Resolver::ResolveDeclaration(Declaration* const declaration)
+{
+	// Redefinitions fail at runtime before the variable is added, so they are left unresolved and do not take slot
+	if (FindVariable(declaration->identifier) || functions.contains(declaration->identifier))
+	{
+		declaration->variableSlot = std::nullopt;
+		return;
+	}
+	// Variable is added before its initial value is evaluated
+	declaration->variableSlot = VariableSlot{ 0, static_cast<unsigned int>(scopes.back().size()) };
+	scopes.back().push_back(declaration->identifier);
+	ResolveExpression(declaration->expression.get());
+}
+
+void Resolver::ResolveFunctionCall(FunctionCall* const functionCall)
+{
+	if (!functionCall)
+	{
+		return;
+	}
+	functionCall->variableSlot = FindVariable(functionCall->identifier);
+	functionCall->functionDefinition = FindFunction(functionCall->identifier);
+	for (const auto& arg : functionCall->arguments)
+	{
+		ResolveExpression(arg.get());
+	}
+}
+
+void Resolver::ResolveExpression(Expression* const expression)
+{
+	if (auto standardExpression = dynamic_cast<StandardExpression*>(expression))
+	{
+		ResolveStandardExpression(standardExpression);
+	}
+	else if (auto funcExpression = dynamic_cast<FuncExpression*>(expression))
+	{
+		ResolveFuncExpression(funcExpression);
+	}
+}
+
+void Resolver::ResolveStandardExpression(StandardExpression* const expression)
+{
+	if (!expression)
+	{
+		return;
+	}
+	for (const auto& conjunction : expression->conjunctions)
+	{
+		for (const auto& relation : conjunction->relations)
+		{
+			ResolveAdditive(relation->firstAdditive.get());
+			ResolveAdditive(relation->secondAdditive.get());
+		}
+	}
+}
+
+void Resolver::ResolveAdditive(Additive* const additive)
+{
+	if (!additive)
+	{
+		return;
+	}
+	for (const auto& multiplicative : additive->multiplicatives)
+	{
+		for (const auto& factor : multiplicative->factors)
+		{
+			ResolveFactor(factor.get());
+		}
+	}
+}
+
+void Resolver::ResolveFactor(Factor* const factor)
+{
+	if (auto identifier = std::get_if<Symbol>(&factor->factor))
+	{
+		factor->variableSlot = FindVariable(*identifier);
+	}
+	else if (auto stdExpr = std::get_if<std::unique_ptr<StandardExpression>>(&factor->factor))
+	{
+		ResolveStandardExpression(stdExpr->get());
+	}
+	else if (auto funcCall = std::get_if<std::unique_ptr<FunctionCall>>(&factor->factor))
+	{
+		ResolveFunctionCall(funcCall->get());
+	}
+}
+
+void Resolver::ResolveFuncExpression(FuncExpression* const funcExpression)
+{
+	for (const auto& composable : funcExpression->composables)
+	{
+		ResolveBindable(composable->bindable.get());
+		for (const auto& arg : composable->arguments)
+		{
+			ResolveExpression(arg.get());
+		}
+	}
+}
+
+void Resolver::ResolveBindable(Bindable* const bindable)
+{
+	if (!bindable)
+	{
+		return;
+	}
+	if (auto funcLit = std::get_if<std::unique_ptr<FunctionLiteral>>(&bindable->bindable))
+	{
+		ResolveFunction((*funcLit)->parameters, (*funcLit)->block.get());
+	}
+	else if (auto funcExpr = std::get_if<std::unique_ptr<FuncExpression>>(&bindable->bindable))
+	{
+		ResolveFuncExpression(funcExpr->get());
+	}
+	else if (auto funcCall = std::get_if<std::unique_ptr<FunctionCall>>(&bindable->bindable))
+	{
+		ResolveFunctionCall(funcCall->get());
+	}
+	else if (auto identifier = std::get_if<Symbol>(&bindable->bindable))
+	{
+		bindable->variableSlot = FindVariable(*identifier);
+		bindable->functionDefinition = FindFunction(*identifier);
+	}
+}
+
+std::optional<VariableSlot> Resolver::FindVariable(const Symbol identifier) const noexcept
+{
+	for (size_t depth = 0; depth < scopes.size(); ++depth)
+	{
+		const auto& scope = scopes[scopes.size() - 1 - depth];
+		for (size_t slot = 0; slot < scope.size(); ++slot)
+		{
+			if (scope[slot] == identifier)
+			{
+				return VariableSlot{ static_cast<unsigned int>(depth), static_cast<unsigned int>(slot) };
+			}
+		}
+	}
+	return std::nullopt;
+}
+
+const FunctionDefiniton* Resolver::FindFunction(const Symbol identifier) const noexcept
+{
+	const auto it = functions.find(identifier);
+	return (it != functions.end()) ? it->second : nullptr;
+}
+
+const Additive* Resolver::FindSelfAppend(const Assignment* const assignment) noexcept
+{
+	const auto expression = dynamic_cast<const StandardExpression*>(assignment->expression.get());
+	if (!expression || expression->conjunctions.size() != 1 || expression->conjunctions.front()->relations.size() != 1)
+	{
+		return nullptr;
+	}
+	const auto& relation = expression->conjunctions.front()->relations.front();
+	const auto additive = relation->firstAdditive.get();
+	if (relation->relationOperator || !additive || additive->negated || additive->operators.empty())
+	{
+		return nullptr;
+	}
+	for (const auto additionOperator : additive->operators)
+	{
+		if (additionOperator != AdditionOperator::Plus)
+		{
+			return nullptr;
+		}
+	}
+	const auto& factors = additive->multiplicatives.front()->factors;
+	if (factors.size() != 1 || factors.front()->logicallyNegated)
+	{
+		return nullptr;
+	}
+	const auto identifier = std::get_if<Symbol>(&factors.front()->factor);
+	return (identifier && *identifier == assignment->identifier) ? additive : nullptr;
+}
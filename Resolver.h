@@ -0,0 +1,35 @@
+#pragma once
+#include "ParserObjects/ParserObjects.h"
+#include <unordered_map>
+
+// Annotates identifier uses with VariableSlot so the Interpreter can load variables by index.
+// Scopes are mirrored exactly as the Interpreter creates them: one for function parameters and one per executed block.
+// Function identifiers are bound to their FunctionDefiniton.
+// Uses that can not be resolved are left without slot and fall back to lookup by name.
+class Resolver
+{
+public:
+	void Resolve(Program* const program);
+
+private:
+	void ResolveFunction(const std::vector<Param>& parameters, Block* const block);
+	void ResolveBlock(Block* const block);
+	void ResolveStatement(Statement* const statement);
+	void ResolveDeclaration(Declaration* const declaration);
+	void ResolveFunctionCall(FunctionCall* const functionCall);
+
+	void ResolveExpression(Expression* const expression);
+	void ResolveStandardExpression(StandardExpression* const expression);
+	void ResolveAdditive(Additive* const additive);
+	void ResolveFactor(Factor* const factor);
+	void ResolveFuncExpression(FuncExpression* const funcExpression);
+	void ResolveBindable(Bindable* const bindable);
+
+	std::optional<VariableSlot> FindVariable(const Symbol identifier) const noexcept;
+	const FunctionDefiniton* FindFunction(const Symbol identifier) const noexcept;
+	static const Additive* FindSelfAppend(const Assignment* const assignment) noexcept;
+
+private:
+	std::vector<std::vector<Symbol>> scopes;
+	std::unordered_map<Symbol, const FunctionDefiniton*> functions;
+};
@@ -5,7 +5,7 @@
 
 namespace StringConversion
 {
-	std::string ToNarrow(const std::wstring& str)
+	inline std::string ToNarrow(const std::wstring& str)
 	{
 		if (str.empty()) return std::string();
 
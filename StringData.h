@@ -0,0 +1,26 @@
+#pragma once
+#include <optional>
+#include <string>
+#include "RefPtr.h"
+
+// String payload which remembers its numeric interpretation after the first coercion.
+// Kept apart from Value so parsed string literals can hold their interned payload.
+class StringData
+{
+public:
+	explicit StringData(const std::wstring& text);
+	explicit StringData(std::wstring&& text) noexcept;
+	const std::wstring& GetText() const noexcept;
+	// Only valid while the payload is uniquely owned, shared strings are never modified
+	void Append(const std::wstring& suffix);
+	std::optional<int> AsInt() const;
+	std::optional<float> AsFloat() const;
+
+private:
+	void Classify() const;
+
+	std::wstring text;
+	mutable bool classified = false;
+	mutable std::optional<int> intValue;
+	mutable std::optional<float> floatValue;
+};
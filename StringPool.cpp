@@ -0,0 +1,31 @@
+#include "StringPool.h"
+
+Value::StringRef StringPool::Intern(const std::wstring& text)
+{
+	const auto it = strings.find(std::wstring_view(text));
+	if (it != strings.end())
+	{
+		return *it;
+	}
+	return *strings.insert(Value::StringRef::Make(text)).first;
+}
+
+size_t StringPool::GetSize() const noexcept
+{
+	return strings.size();
+}
+
+void StringPool::Clear() noexcept
+{
+	strings.clear();
+}
+
+std::wstring_view StringPool::View(const Value::StringRef& string) noexcept
+{
+	return string->GetText();
+}
+
+std::wstring_view StringPool::View(const std::wstring_view text) noexcept
+{
+	return text;
+}
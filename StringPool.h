@@ -0,0 +1,40 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include "Value.h"
+
+// Interns string payloads, so equal literals share one immutable buffer and its numeric interpretation.
+class StringPool
+{
+public:
+	Value::StringRef Intern(const std::wstring& text);
+	size_t GetSize() const noexcept;
+	void Clear() noexcept;
+
+private:
+	static std::wstring_view View(const Value::StringRef& string) noexcept;
+	static std::wstring_view View(const std::wstring_view text) noexcept;
+
+	struct Hash
+	{
+		using is_transparent = void;
+		template<typename Text>
+		size_t operator()(const Text& text) const noexcept
+		{
+			return std::hash<std::wstring_view>()(View(text));
+		}
+	};
+
+	struct Equal
+	{
+		using is_transparent = void;
+		template<typename Left, typename Right>
+		bool operator()(const Left& left, const Right& right) const noexcept
+		{
+			return View(left) == View(right);
+		}
+	};
+
+	std::unordered_set<Value::StringRef, Hash, Equal> strings;
+};
@@ -0,0 +1,88 @@
+#include "Symbol.h"
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+// Entries are never removed, so symbols stay valid for the whole run and are read without locking
+struct Symbol::Table
+{
+	std::mutex mutex;
+	std::deque<Entry> entries;
+	std::unordered_map<std::wstring_view, const Entry*> index;
+};
+
+namespace
+{
+	const std::wstring emptyName;
+}
+
+Symbol::Symbol(const std::wstring_view name) :
+	entry(name.empty() ? nullptr : Intern(name))
+{
+}
+
+Symbol::Symbol(const std::wstring& name) :
+	Symbol(std::wstring_view(name))
+{
+}
+
+Symbol::Symbol(const wchar_t* const name) :
+	Symbol(std::wstring_view(name))
+{
+}
+
+uint32_t Symbol::GetId() const noexcept
+{
+	return entry ? entry->id : 0;
+}
+
+const std::wstring& Symbol::GetName() const noexcept
+{
+	return entry ? entry->name : emptyName;
+}
+
+bool Symbol::IsEmpty() const noexcept
+{
+	return entry == nullptr;
+}
+
+bool Symbol::operator==(const std::wstring_view name) const noexcept
+{
+	return GetName() == name;
+}
+
+bool Symbol::operator==(const std::wstring& name) const noexcept
+{
+	return GetName() == name;
+}
+
+bool Symbol::operator==(const wchar_t* const name) const noexcept
+{
+	return GetName() == name;
+}
+
+size_t Symbol::GetTableSize() noexcept
+{
+	auto& table = GetTable();
+	std::lock_guard lock(table.mutex);
+	return table.entries.size();
+}
+
+Symbol::Table& Symbol::GetTable()
+{
+	static Table table;
+	return table;
+}
+
+const Symbol::Entry* Symbol::Intern(const std::wstring_view name)
+{
+	auto& table = GetTable();
+	std::lock_guard lock(table.mutex);
+	if (const auto it = table.index.find(name); it != table.index.end())
+	{
+		return it->second;
+	}
+	const auto& entry = table.entries.emplace_back(Entry{ std::wstring(name), static_cast<uint32_t>(table.entries.size() + 1) });
+	table.index.emplace(entry.name, &entry);
+	return &entry;
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+// Identifier interned once in the process wide symbol table.
+// Symbols of equal names share one entry, so comparing and hashing them never touches the characters.
+class Symbol
+{
+public:
+	Symbol() noexcept = default;
+	Symbol(const std::wstring_view name);
+	Symbol(const std::wstring& name);
+	Symbol(const wchar_t* const name);
+
+	// Zero for the empty symbol, ids of interned names start at 1
+	uint32_t GetId() const noexcept;
+	const std::wstring& GetName() const noexcept;
+	bool IsEmpty() const noexcept;
+
+	bool operator==(const Symbol& other) const noexcept = default;
+	bool operator==(const std::wstring_view name) const noexcept;
+	bool operator==(const std::wstring& name) const noexcept;
+	bool operator==(const wchar_t* const name) const noexcept;
+
+	// Number of distinct names interned so far
+	static size_t GetTableSize() noexcept;
+
+private:
+	struct Entry
+	{
+		std::wstring name;
+		uint32_t id;
+	};
+	struct Table;
+	static Table& GetTable();
+	static const Entry* Intern(const std::wstring_view name);
+
+	const Entry* entry = nullptr;
+};
+
+template<>
+struct std::hash<Symbol>
+{
+	size_t operator()(const Symbol& symbol) const noexcept
+	{
+		return std::hash<uint32_t>()(symbol.GetId());
+	}
+};
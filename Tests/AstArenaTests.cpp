@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include "Parser.h"
+#include "ParallelParser.h"
+
+static std::unique_ptr<Program> ParseProgram(const std::wstring& code)
+{
+	Lexer lexer(std::wstring_view{ code });
+	const auto tokens = lexer.Tokenize();
+	Parser parser(&tokens);
+	return parser.ParseProgram();
+}
+
+TEST(AstArenaTests, ParsedNodesComeFromProgramArena)
+{
+	const auto program = ParseProgram(L"func Main() { return 1; }");
+
+	// Function definition, block, return and six nodes of the expression cascade down to the literal factor,
+	// plus the declaration allocated before the statement turned out to be a return
+	EXPECT_EQ(program->arena.GetNodeCount(), 10);
+	EXPECT_GE(program->arena.GetByteCount(), sizeof(FunctionDefiniton) + sizeof(Block) + sizeof(Return) + sizeof(Factor));
+	EXPECT_GE(program->arena.GetReservedByteCount(), program->arena.GetByteCount());
+}
+
+TEST(AstArenaTests, NodesOutsideOfScopeComeFromHeap)
+{
+	AstArena arena;
+	auto heapFactor = std::make_unique<Factor>(Literal{ 1 });
+	EXPECT_EQ(arena.GetNodeCount(), 0);
+	{
+		const AstArena::Scope scope(arena);
+		auto arenaFactor = std::make_unique<Factor>(Literal{ 2 });
+		auto arenaBlock = std::make_unique<Block>();
+		EXPECT_EQ(std::get<int>(std::get<Literal>(arenaFactor->factor).value), 2);
+	}
+	// Destroyed nodes leave their memory to the arena
+	EXPECT_EQ(arena.GetNodeCount(), 2);
+	heapFactor.reset();
+	auto laterFactor = std::make_unique<Factor>(Literal{ 3 });
+	EXPECT_EQ(arena.GetNodeCount(), 2);
+}
+
+TEST(AstArenaTests, ParallelParserKeepsNodesOfAllParts)
+{
+	std::wstring code;
+	for (int i = 0; i < 100; ++i)
+	{
+		code += L"func F" + std::to_wstring(i) + L"(a) { var b = a * 2 + \"text\"; return [F0 << (b)]; }\n";
+	}
+	const auto expectedProgram = ParseProgram(code);
+	const auto program = ParallelParser(4).ParseProgram(std::wstring_view{ code });
+
+	ASSERT_EQ(program->funDefs.size(), 100);
+	EXPECT_EQ(program->arena.GetNodeCount(), expectedProgram->arena.GetNodeCount());
+	EXPECT_EQ(program->arena.GetByteCount(), expectedProgram->arena.GetByteCount());
+}
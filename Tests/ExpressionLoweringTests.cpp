@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "Interpreter.h"
+#include "Parser.h"
+#include "TraceOutput.h"
+
+using Kind = ExpressionNode::Kind;
+
+static std::unique_ptr<Program> ParseProgram(const std::wstring& code)
+{
+	Lexer lexer(std::wstring_view{ code });
+	const auto tokens = lexer.Tokenize();
+	Parser parser(&tokens);
+	return parser.ParseProgram();
+}
+
+static const StandardExpression* GetDeclaredExpression(const Program* const program, const size_t statementIndex)
+{
+	const auto& statement = program->funDefs.front()->block->statements[statementIndex];
+	return dynamic_cast<const StandardExpression*>(dynamic_cast<const Declaration*>(statement.get())->expression.get());
+}
+
+static std::vector<Kind> GetKinds(const StandardExpression* const expression)
+{
+	std::vector<Kind> kinds;
+	for (const auto& node : expression->lowered)
+	{
+		kinds.push_back(node.kind);
+	}
+	return kinds;
+}
+
+static std::string InterpretWithOutput(const Program* const program)
+{
+	Interpreter interpreter;
+	return InterpretWithOutput(interpreter, program);
+}
+
+TEST(ExpressionLoweringTests, SingleChildLevelsDisappear)
+{
+	const auto program = ParseProgram(L"func Main() { var a = 1; var b = a; var c = (((a))); }");
+
+	EXPECT_EQ(GetKinds(GetDeclaredExpression(program.get(), 0)), std::vector<Kind>{ Kind::Literal });
+	EXPECT_EQ(GetKinds(GetDeclaredExpression(program.get(), 1)), std::vector<Kind>{ Kind::Factor });
+	EXPECT_EQ(GetKinds(GetDeclaredExpression(program.get(), 2)), std::vector<Kind>{ Kind::Factor });
+}
+
+TEST(ExpressionLoweringTests, OperatorsBecomeBinaryNodes)
+{
+	const auto program = ParseProgram(L"func Main() { var a = 1; var b = -(a + 2) * 3 >= 4 || !(a == 1) && true; }");
+	const auto expression = GetDeclaredExpression(program.get(), 1);
+
+	const std::vector<Kind> expectedKinds = {
+		Kind::Factor, Kind::Literal, Kind::Add, Kind::Literal, Kind::Multiply, Kind::Negate, Kind::Literal, Kind::GreaterEqual,
+		Kind::Factor, Kind::Literal, Kind::Equal, Kind::LogicalNot, Kind::Literal, Kind::And, Kind::Or
+	};
+	EXPECT_EQ(GetKinds(expression), expectedKinds);
+	const auto& root = expression->lowered.back();
+	EXPECT_EQ(root.left, 7);
+	EXPECT_EQ(root.right, 13);
+}
+
+TEST(ExpressionLoweringTests, LoweredAndCascadeEvaluateTheSame)
+{
+	if (!Tracer::compiledIn) GTEST_SKIP() << "Tracing is compiled out";
+	const std::wstring code = LR"(
+	func Main()
+	{
+		var a = 7;
+		var b = 2.5;
+		var c = "12";
+		var d = a + b * 2 - a / 2;
+		var e = -(a - 10) * (c + 1);
+		var f = a > 3 && b < 1 || c == "12";
+		var g = !(a != 7) || a / 0 == 1;
+		var h = (a >= 7) && (b <= 2.5) && !false;
+		var i = c + a + "x";
+		var j = !a;
+		var k = a - "text";
+	}
+	)";
+	const auto loweredProgram = ParseProgram(code);
+	auto cascadeProgram = ParseProgram(code);
+	for (const auto& statement : cascadeProgram->funDefs.front()->block->statements)
+	{
+		auto declaration = dynamic_cast<Declaration*>(statement.get());
+		auto expression = dynamic_cast<StandardExpression*>(declaration->expression.get());
+		ASSERT_FALSE(expression->lowered.empty());
+		expression->lowered.clear();
+	}
+
+	const auto output = InterpretWithOutput(loweredProgram.get());
+	EXPECT_NE(output.find("Declaration j"), std::string::npos);
+	EXPECT_EQ(output.find("Declaration k"), std::string::npos);
+	EXPECT_EQ(output, InterpretWithOutput(cascadeProgram.get()));
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "FrameStack.h"
+#include "Interpreter.h"
+#include <ParserImpl.h>
+
+static std::unique_ptr<Program> ParseStringAsProgram(const std::wstring& input) {
+	std::wstringstream inputStream(input);
+	Lexer lexer(&inputStream);
+	ParserImpl parser(&lexer);
+	return parser.ParseProgram();
+}
+
+TEST(FrameStackTests, GetVariable_SearchesEnclosingBlocks) {
+	FrameStack frameStack;
+	frameStack.PushFunctionFrame(true);
+	frameStack.PushVariable(false, L"a", Value(1));
+	frameStack.PushBlockFrame();
+	frameStack.PushVariable(true, L"b", Value(2));
+
+	auto a = frameStack.GetVariable(L"a");
+	ASSERT_NE(a, nullptr);
+	EXPECT_EQ(std::get<int>(a->value->value), 1);
+	auto b = frameStack.GetVariable(L"b");
+	ASSERT_NE(b, nullptr);
+	EXPECT_TRUE(b->isMutable);
+	EXPECT_TRUE(frameStack.ValueExpectedInCurrentFunction());
+
+	frameStack.PopFrame();
+	EXPECT_EQ(frameStack.GetVariable(L"b"), nullptr);
+	EXPECT_NE(frameStack.GetVariable(L"a"), nullptr);
+}
+
+TEST(FrameStackTests, GetVariable_DoesNotCrossFunctionFrame) {
+	FrameStack frameStack;
+	frameStack.PushFunctionFrame(true);
+	frameStack.PushVariable(false, L"a", Value(1));
+	frameStack.PushFunctionFrame(false);
+	frameStack.PushBlockFrame();
+
+	EXPECT_EQ(frameStack.GetVariable(L"a"), nullptr);
+	EXPECT_FALSE(frameStack.VariableAlreadyExists(L"a"));
+	EXPECT_FALSE(frameStack.ValueExpectedInCurrentFunction());
+	EXPECT_EQ(frameStack.GetVariable(VariableSlot{ 2, 0 }), nullptr);
+}
+
+TEST(FrameStackTests, GetVariable_BySlot) {
+	FrameStack frameStack;
+	frameStack.PushFunctionFrame(true);
+	frameStack.PushVariable(false, L"a", Value(1));
+	frameStack.PushVariable(false, L"b", Value(2));
+	frameStack.PushBlockFrame();
+	frameStack.PushVariable(false, L"c", Value(3));
+
+	auto b = frameStack.GetVariable(VariableSlot{ 1, 1 });
+	ASSERT_NE(b, nullptr);
+	EXPECT_EQ(b->identifier, L"b");
+	auto c = frameStack.GetVariable(VariableSlot{ 0, 0 });
+	ASSERT_NE(c, nullptr);
+	EXPECT_EQ(c->identifier, L"c");
+	EXPECT_EQ(frameStack.GetVariable(VariableSlot{ 0, 1 }), nullptr);
+}
+
+TEST(FrameStackTests, PushVariable_KeepsAddressesStable) {
+	FrameStack frameStack;
+	frameStack.PushFunctionFrame(true);
+	auto& first = frameStack.PushVariable(true, L"first", Value(0));
+	for (int i = 0; i < 1000; ++i)
+	{
+		frameStack.PushVariable(false, L"v" + std::to_wstring(i), Value(i));
+	}
+	EXPECT_EQ(&first, frameStack.GetVariable(L"first"));
+}
+
+TEST(FrameStackTests, Interpret_LoopDoesNotAllocateFrames) {
+	const std::wstring programTemplate = LR"(
+	func Main()
+	{
+		mut var i = ITERATIONS;
+		while(i > 0)
+		{
+			var a = i;
+			if(a > 1)
+			{
+				var b = a;
+			}
+			else
+			{
+				var c = a;
+			}
+			i = i - 1;
+		}
+		return i;
+	}
+	)";
+	auto makeProgram = [&programTemplate](const std::wstring& iterations)
+	{
+		auto code = programTemplate;
+		code.replace(code.find(L"ITERATIONS"), 10, iterations);
+		return ParseStringAsProgram(code);
+	};
+	auto shortProgram = makeProgram(L"2");
+	auto longProgram = makeProgram(L"500");
+
+	testing::internal::CaptureStdout();
+	Interpreter shortInterpreter;
+	shortInterpreter.Interpret(shortProgram.get());
+	Interpreter longInterpreter;
+	longInterpreter.Interpret(longProgram.get());
+	testing::internal::GetCapturedStdout();
+
+	EXPECT_GT(shortInterpreter.GetHeapAllocationsCount(), 0);
+	EXPECT_EQ(longInterpreter.GetHeapAllocationsCount(), shortInterpreter.GetHeapAllocationsCount());
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include "Interpreter.h"
 #include <ParserImpl.h>
+#include "TraceOutput.h"
 
 static std::unique_ptr<Program> ParseStringAsProgram(const std::wstring& input) {
 	std::wstringstream inputStream(input);
@@ -147,7 +148,22 @@ TEST_F(InterpreterTests, EvaluateLiteralString)
 	Literal literal;
 	literal.value = std::wstring(L"test");
 	Value result = interpreter.EvaluateLiteral(literal);
-	EXPECT_EQ(std::get<std::wstring>(result.value), L"test");
+	EXPECT_EQ(*result.GetString(), L"test");
+}
+
+static Value EvaluateStringLiteral(InterpreterTest& interpreter, const std::wstring& text)
+{
+	Literal literal;
+	literal.value = text;
+	return interpreter.EvaluateLiteral(literal);
+}
+
+TEST_F(InterpreterTests, EvaluateLiteralString_DifferentLiteralsAtSameAddress)
+{
+	const auto first = EvaluateStringLiteral(interpreter, L"first");
+	const auto second = EvaluateStringLiteral(interpreter, L"second");
+	EXPECT_EQ(*first.GetString(), L"first");
+	EXPECT_EQ(*second.GetString(), L"second");
 }
 
 TEST_F(InterpreterTests, EvaluateLiteralFloat)
@@ -187,8 +203,8 @@ TEST_F(InterpreterTests, EvaluateFactor_WithStringLiteral) {
 
 	Value result = interpreter.EvaluateFactor(&factor);
 
-	ASSERT_TRUE(std::holds_alternative<std::wstring>(result.value));
-	EXPECT_EQ(std::get<std::wstring>(result.value), L"test");
+	ASSERT_TRUE(result.GetString() != nullptr);
+	EXPECT_EQ(*result.GetString(), L"test");
 }
 
 TEST_F(InterpreterTests, EvaluateMultiplicative_SingleFactor) {
@@ -383,8 +399,8 @@ TEST_F(InterpreterTests, EvaluateFunctionLiteral_ValidFunctionLiteral_ReturnsFun
 
 	Value result = interpreter.EvaluateFunctionLiteral(&functionLiteral);
 
-	ASSERT_TRUE(std::holds_alternative<Value::Function>(result.value));
-	const auto& function = std::get<Value::Function>(result.value);
+	ASSERT_TRUE(result.GetFunction() != nullptr);
+	const auto& function = *result.GetFunction();
 	EXPECT_EQ(function.parameters.size(), 2);
 	EXPECT_EQ(function.parameters[0].identifier, L"param1");
 	EXPECT_EQ(function.parameters[1].identifier, L"param2");
@@ -398,8 +414,8 @@ TEST_F(InterpreterTests, EvaluateFunctionLiteral_EmptyParameters_ReturnsFunction
 
 	Value result = interpreter.EvaluateFunctionLiteral(&functionLiteral);
 
-	ASSERT_TRUE(std::holds_alternative<Value::Function>(result.value));
-	const auto& function = std::get<Value::Function>(result.value);
+	ASSERT_TRUE(result.GetFunction() != nullptr);
+	const auto& function = *result.GetFunction();
 	EXPECT_TRUE(function.parameters.empty());
 	EXPECT_EQ(function.block, functionLiteral.block.get());
 }
@@ -418,8 +434,8 @@ TEST_F(InterpreterTests, EvaluateFunctionLiteral_SingleParameter_ReturnsFunction
 
 	Value result = interpreter.EvaluateFunctionLiteral(&functionLiteral);
 
-	ASSERT_TRUE(std::holds_alternative<Value::Function>(result.value));
-	const auto& function = std::get<Value::Function>(result.value);
+	ASSERT_TRUE(result.GetFunction() != nullptr);
+	const auto& function = *result.GetFunction();
 	EXPECT_EQ(function.parameters.size(), 1);
 	EXPECT_EQ(function.parameters[0].identifier, L"param1");
 	EXPECT_EQ(function.block, functionLiteral.block.get());
@@ -432,8 +448,8 @@ TEST_F(InterpreterTests, EvaluateFunctionLiteral_MultipleParameters_ReturnsFunct
 
 	Value result = interpreter.EvaluateFunctionLiteral(&functionLiteral);
 
-	ASSERT_TRUE(std::holds_alternative<Value::Function>(result.value));
-	const auto& function = std::get<Value::Function>(result.value);
+	ASSERT_TRUE(result.GetFunction() != nullptr);
+	const auto& function = *result.GetFunction();
 	EXPECT_EQ(function.parameters.size(), 3);
 	EXPECT_EQ(function.parameters[0].identifier, L"param1");
 	EXPECT_EQ(function.parameters[1].identifier, L"param2");
@@ -448,8 +464,8 @@ TEST_F(InterpreterTests, EvaluateFunctionLiteral_EmptyBlock_ReturnsFunctionValue
 
 	Value result = interpreter.EvaluateFunctionLiteral(&functionLiteral);
 
-	ASSERT_TRUE(std::holds_alternative<Value::Function>(result.value));
-	const auto& function = std::get<Value::Function>(result.value);
+	ASSERT_TRUE(result.GetFunction() != nullptr);
+	const auto& function = *result.GetFunction();
 	EXPECT_EQ(function.parameters.size(), 1);
 	EXPECT_EQ(function.parameters[0].identifier, L"param1");
 	EXPECT_EQ(function.block, functionLiteral.block.get());
@@ -463,8 +479,8 @@ TEST_F(InterpreterTests, EvaluateFunctionLiteral_NonEmptyBlock_ReturnsFunctionVa
 
 	Value result = interpreter.EvaluateFunctionLiteral(&functionLiteral);
 
-	ASSERT_TRUE(std::holds_alternative<Value::Function>(result.value));
-	const auto& function = std::get<Value::Function>(result.value);
+	ASSERT_TRUE(result.GetFunction() != nullptr);
+	const auto& function = *result.GetFunction();
 	EXPECT_EQ(function.parameters.size(), 1);
 	EXPECT_EQ(function.parameters[0].identifier, L"param1");
 	EXPECT_EQ(function.block, functionLiteral.block.get());
@@ -597,6 +613,7 @@ TEST(CaptureStdoutTest, CapturesOutput) {
 }
 
 TEST_F(InterpreterTests, CaptureOutput_FunctionComposition) {
+	if (!Tracer::compiledIn) GTEST_SKIP() << "Tracing is compiled out";
 	std::wstring programCode = LR"(
 	func Main()
 	{
@@ -619,17 +636,14 @@ TEST_F(InterpreterTests, CaptureOutput_FunctionComposition) {
 	)";
 	auto program = ParseStringAsProgram(programCode);
 
-	testing::internal::CaptureStdout();
-
-	interpreter.Interpret(program.get());
-
-	std::string output = testing::internal::GetCapturedStdout();
+	std::string output = InterpretWithTrace(interpreter, program.get());
 
 	std::string expectedOutput = "Function: Main Arguments: \n\tDeclaration e = Function\n\tDeclaration b = Function\n\tFunction from variable, Arguments: 1 2 3 \n\t\tDeclaration d = 6\n\t\tReturn 6\n\tFunction from variable, Arguments: 6 \n\t\tDeclaration d = 16\n\t\tReturn 16\n\tReturn 16\n";
 	EXPECT_EQ(output, expectedOutput);
 }
 
 TEST_F(InterpreterTests, CaptureOutput_FunctionBinding) {
+	if (!Tracer::compiledIn) GTEST_SKIP() << "Tracing is compiled out";
 	std::wstring programCode = LR"(
     func Main()
     {
@@ -645,17 +659,14 @@ TEST_F(InterpreterTests, CaptureOutput_FunctionBinding) {
     )";
 	auto program = ParseStringAsProgram(programCode);
 
-	testing::internal::CaptureStdout();
-
-	interpreter.Interpret(program.get());
-
-	std::string output = testing::internal::GetCapturedStdout();
+	std::string output = InterpretWithTrace(interpreter, program.get());
 
 	std::string expectedOutput = "Function: Main Arguments: \n\tDeclaration e = Function\n\tFunction from variable, Arguments: 1 2 3 \n\t\tDeclaration d = 6\n\t\tReturn 6\n\tReturn 6\n";
 	EXPECT_EQ(output, expectedOutput);
 }
 
 TEST_F(InterpreterTests, CaptureOutput_FunctionCompositionAndBinding) {
+	if (!Tracer::compiledIn) GTEST_SKIP() << "Tracing is compiled out";
 	std::wstring programCode = LR"(
     func Main()
     {
@@ -678,17 +689,14 @@ TEST_F(InterpreterTests, CaptureOutput_FunctionCompositionAndBinding) {
     )";
 	auto program = ParseStringAsProgram(programCode);
 
-	testing::internal::CaptureStdout();
-
-	interpreter.Interpret(program.get());
-
-	std::string output = testing::internal::GetCapturedStdout();
+	std::string output = InterpretWithTrace(interpreter, program.get());
 
 	std::string expectedOutput = "Function: Main Arguments: \n\tDeclaration e = Function\n\tAssignment e = Function\n\tFunction from variable, Arguments: 1 2 3 \n\t\tDeclaration d = 6\n\t\tReturn 6\n\tFunction from variable, Arguments: 6 \n\t\tDeclaration d = 16\n\t\tReturn 16\n\tReturn 16\n";
 	EXPECT_EQ(output, expectedOutput);
 }
 
 TEST_F(InterpreterTests, CaptureOutput_FunctionLiteralWithBinding) {
+	if (!Tracer::compiledIn) GTEST_SKIP() << "Tracing is compiled out";
 	std::wstring programCode = LR"(
     func Main()
     {
@@ -698,17 +706,14 @@ TEST_F(InterpreterTests, CaptureOutput_FunctionLiteralWithBinding) {
     )";
 	auto program = ParseStringAsProgram(programCode);
 
-	testing::internal::CaptureStdout();
-
-	interpreter.Interpret(program.get());
-
-	std::string output = testing::internal::GetCapturedStdout();
+	std::string output = InterpretWithTrace(interpreter, program.get());
 
 	std::string expectedOutput = "Function: Main Arguments: \n\tDeclaration e = Function\n\tFunction from variable, Arguments: 10 5 \n\t\tReturn 15\n\tReturn 15\n";
 	EXPECT_EQ(output, expectedOutput);
 }
 
 TEST_F(InterpreterTests, CaptureOutput_FunctionLiteralWithComposition) {
+	if (!Tracer::compiledIn) GTEST_SKIP() << "Tracing is compiled out";
 	std::wstring programCode = LR"(
     func Main()
     {
@@ -718,11 +723,7 @@ TEST_F(InterpreterTests, CaptureOutput_FunctionLiteralWithComposition) {
     )";
 	auto program = ParseStringAsProgram(programCode);
 
-	testing::internal::CaptureStdout();
-
-	interpreter.Interpret(program.get());
-
-	std::string output = testing::internal::GetCapturedStdout();
+	std::string output = InterpretWithTrace(interpreter, program.get());
 
 	std::string expectedOutput = "Function: Main Arguments: \n\tDeclaration e = Function\n\tFunction from variable, Arguments: 5 \n\t\tReturn 6\n\tFunction from variable, Arguments: 6 \n\t\tReturn 12\n\tReturn 12\n";
 	EXPECT_EQ(output, expectedOutput);
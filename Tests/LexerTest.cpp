@@ -1,7 +1,10 @@
 #include <gtest/gtest.h>
 
 #include <sstream>
+#include <fstream>
+#include <filesystem>
 #include "Lexer.h"
+#include "MappedFile.h"
 
 class LexerTest : public ::testing::Test
 {
@@ -19,7 +22,12 @@ static void CompareTokens(const std::vector<LexToken>& tokens, const std::vector
 		EXPECT_EQ(tokens[i].GetPosition().line, expectedTokens[i].GetPosition().line);
 		EXPECT_EQ(tokens[i].GetPosition().column, expectedTokens[i].GetPosition().column);
 
-		if (tokens[i].GetValue().index() == expectedTokens[i].GetValue().index())
+		// Lexed string literals view their text, expected ones own it
+		if (std::holds_alternative<std::wstring_view>(tokens[i].GetValue()) || std::holds_alternative<std::wstring_view>(expectedTokens[i].GetValue()))
+		{
+			EXPECT_EQ(tokens[i].GetText(), expectedTokens[i].GetText());
+		}
+		else if (tokens[i].GetValue().index() == expectedTokens[i].GetValue().index())
 		{
 			if (std::holds_alternative<float>(tokens[i].GetValue()))
 			{
@@ -1116,4 +1124,280 @@ TEST_F(LexerTest, StringLiteralsComplexScenarios)
 
 	CompareTokens(lexerOut.first, expectedTokens);
 	CompareErrors(lexerOut.second, expectedErrors);
-}
\ No newline at end of file
+}
+TEST_F(LexerTest, BlockBoundariesMatchInPlaceText)
+{
+	std::wstring code;
+	for (int i = 0; i < 4000; ++i)
+	{
+		code += L"var abc" + std::to_wstring(i) + L" = 12.5 >= x && \"str\\\"ing\"; # comment\n";
+	}
+	std::wstringstream stream(code);
+	Lexer streamLexer(&stream);
+	Lexer textLexer(std::wstring_view{ code });
+
+	const auto [streamTokens, streamErrors] = streamLexer.ResolveAllRemaining();
+	const auto [textTokens, textErrors] = textLexer.ResolveAllRemaining();
+
+	EXPECT_TRUE(streamErrors.empty());
+	EXPECT_TRUE(textErrors.empty());
+	EXPECT_EQ(streamTokens.size(), 4000 * 10 + 1);
+	CompareTokens(streamTokens, textTokens);
+}
+
+TEST_F(LexerTest, TwoCharsOperatorCheckAtEndOfInput)
+{
+	std::wstringstream stream(L"a >");
+	Lexer lexer(&stream);
+	const auto [tokens, errors] = lexer.ResolveAllRemaining();
+
+	const std::vector<LexToken> expectedTokens = {
+		LexToken(LexToken::TokenType::Identifier, Position(1, 1), std::wstring(L"a")),
+		LexToken(LexToken::TokenType::Greater, Position(1, 3)),
+		LexToken(LexToken::TokenType::EndOfFile, Position(1, 4))
+	};
+	EXPECT_TRUE(errors.empty());
+	CompareTokens(tokens, expectedTokens);
+}
+
+TEST_F(LexerTest, Utf8TextDecodesNonAsciiCharacters)
+{
+	// "zażółć" in the string literal and in the comment, BOM at the start is skipped
+	const std::string code = "\xEF\xBB\xBFvar a = \"za\xC5\xBC\xC3\xB3\xC5\x82\xC4\x87\"; # za\xC5\xBC\xC3\xB3\xC5\x82\xC4\x87\nprint(a);";
+	Lexer lexer(std::string_view{ code });
+	const auto [tokens, errors] = lexer.ResolveAllRemaining();
+
+	const std::vector<LexToken> expectedTokens = {
+		LexToken(LexToken::TokenType::Var, Position(1, 1)),
+		LexToken(LexToken::TokenType::Identifier, Position(1, 5), std::wstring(L"a")),
+		LexToken(LexToken::TokenType::Assign, Position(1, 7)),
+		LexToken(LexToken::TokenType::String, Position(1, 9), std::wstring(L"za\u017C\u00F3\u0142\u0107")),
+		LexToken(LexToken::TokenType::Semicolon, Position(1, 17)),
+		LexToken(LexToken::TokenType::Comment, Position(1, 19)),
+		LexToken(LexToken::TokenType::Identifier, Position(2, 1), std::wstring(L"print")),
+		LexToken(LexToken::TokenType::LParenth, Position(2, 6)),
+		LexToken(LexToken::TokenType::Identifier, Position(2, 7), std::wstring(L"a")),
+		LexToken(LexToken::TokenType::RParenth, Position(2, 8)),
+		LexToken(LexToken::TokenType::Semicolon, Position(2, 9)),
+		LexToken(LexToken::TokenType::EndOfFile, Position(2, 10))
+	};
+	EXPECT_TRUE(errors.empty());
+	CompareTokens(tokens, expectedTokens);
+}
+
+TEST_F(LexerTest, Utf8InvalidSequencesBecomeReplacementCharacter)
+{
+	// Stray continuation byte, overlong encoding and sequence cut by the closing quote
+	const std::string code = "\"a\x80" "b\xC0\xAF" "c\xE2\x82\"";
+	Lexer lexer(std::string_view{ code });
+	const auto [tokens, errors] = lexer.ResolveAllRemaining();
+
+	ASSERT_EQ(tokens.size(), 2);
+	EXPECT_EQ(tokens[0].GetType(), LexToken::TokenType::String);
+	EXPECT_EQ(tokens[0].GetText(), L"a\uFFFDb\uFFFDc\uFFFD");
+}
+
+TEST_F(LexerTest, MappedFileMatchesWideStream)
+{
+	const auto path = std::filesystem::temp_directory_path() / "LexerTestMappedFile.txt";
+	std::string code;
+	for (int i = 0; i < 100; ++i)
+	{
+		code += "var abc" + std::to_string(i) + " = 12.5 >= x && \"str\\\"ing\"; # comment\n";
+	}
+	{
+		std::ofstream file(path, std::ios::binary);
+		file << code;
+	}
+	std::wifstream stream(path);
+	Lexer streamLexer(&stream);
+	MappedFile mappedFile;
+	ASSERT_TRUE(mappedFile.Open(path.string()));
+	Lexer mappedLexer(mappedFile.GetText());
+
+	const auto [streamTokens, streamErrors] = streamLexer.ResolveAllRemaining();
+	const auto [mappedTokens, mappedErrors] = mappedLexer.ResolveAllRemaining();
+
+	EXPECT_TRUE(mappedErrors.empty());
+	EXPECT_EQ(mappedTokens.size(), 100 * 10 + 1);
+	CompareTokens(mappedTokens, streamTokens);
+
+	stream.close();
+	mappedFile.Close();
+	std::filesystem::remove(path);
+}
+
+TEST_F(LexerTest, StringLiteralViewsStayValidAcrossBlocks)
+{
+	// Literals fill several literal blocks, earlier tokens still have to view their own text
+	std::wstring code;
+	for (int i = 0; i < 200; ++i)
+	{
+		code += L"\"" + std::wstring(290, wchar_t(L'a' + i % 26)) + L"\\n" + std::to_wstring(i) + L"\" ";
+	}
+	std::wstringstream stream(code);
+	Lexer lexer(&stream);
+	const auto [tokens, errors] = lexer.ResolveAllRemaining();
+
+	EXPECT_TRUE(errors.empty());
+	ASSERT_EQ(tokens.size(), 201);
+	for (int i = 0; i < 200; ++i)
+	{
+		EXPECT_EQ(tokens[i].GetText(), std::wstring(290, wchar_t(L'a' + i % 26)) + L"\n" + std::to_wstring(i));
+	}
+}
+
+TEST_F(LexerTest, TokenizeMatchesResolveAllRemaining)
+{
+	const std::wstring code = L"func main(a) { # comment\n var x = 12 + a; @ y = \"te\\xt\"; return x >= 3.5 && true; }";
+	Lexer streamLexer(std::wstring_view{ code });
+	Lexer batchLexer(std::wstring_view{ code });
+
+	const auto [tokens, errors] = streamLexer.ResolveAllRemaining();
+	const auto buffer = batchLexer.Tokenize();
+
+	ASSERT_EQ(buffer.GetSize(), tokens.size());
+	std::vector<LexToken> bufferTokens;
+	for (size_t i = 0; i < buffer.GetSize(); ++i)
+	{
+		EXPECT_EQ(buffer.GetType(i), tokens[i].GetType());
+		bufferTokens.push_back(buffer.GetToken(i));
+	}
+	CompareTokens(bufferTokens, tokens);
+	EXPECT_TRUE(buffer.IsComplete());
+
+	ASSERT_EQ(buffer.GetErrors().size(), errors.size());
+	ASSERT_EQ(errors.size(), 2);
+	EXPECT_EQ(buffer.GetErrors()[0].error.GetType(), LexicalError::ErrorType::UnrecognizedSymbol);
+	EXPECT_EQ(buffer.GetErrors()[0].tokenIndex, 14);
+	EXPECT_EQ(buffer.GetErrors()[1].error.GetType(), LexicalError::ErrorType::InvalidEscapeSequence);
+	EXPECT_EQ(buffer.GetErrors()[1].tokenIndex, 17);
+}
+
+TEST_F(LexerTest, WhitespaceRunsKeepExactPositions)
+{
+	// Runs of every length up to a few vectors, with newlines at different offsets inside them
+	static constexpr wchar_t whitespace[] = { L' ', L'\t', L' ', L'\r', L' ', L'\v', L'\n', L' ', L'\f' };
+	std::wstring code;
+	std::vector<LexToken> expectedTokens;
+	Position position(1, 1);
+	for (size_t run = 0; run < 80; ++run)
+	{
+		for (size_t i = 0; i < run; ++i)
+		{
+			const wchar_t character = whitespace[(run + i) % std::size(whitespace)];
+			code += character;
+			if (character == L'\n')
+			{
+				++position.line;
+				position.column = 1;
+			}
+			else
+			{
+				++position.column;
+			}
+		}
+		const std::wstring name = L"v" + std::to_wstring(run);
+		expectedTokens.push_back(LexToken(LexToken::TokenType::Identifier, position, name));
+		code += name + L";";
+		expectedTokens.push_back(LexToken(LexToken::TokenType::Semicolon, Position(position.line, position.column + name.size())));
+		position.column += name.size() + 1;
+	}
+	code += L"\n\n   ";
+	expectedTokens.push_back(LexToken(LexToken::TokenType::EndOfFile, Position(position.line + 2, 4)));
+
+	std::wstringstream stream(code);
+	Lexer streamLexer(&stream);
+	Lexer textLexer(std::wstring_view{ code });
+	const std::string utf8Code(code.begin(), code.end());
+	Lexer utf8Lexer(std::string_view{ utf8Code });
+
+	for (Lexer* lexer : { &streamLexer, &textLexer, &utf8Lexer })
+	{
+		const auto [tokens, errors] = lexer->ResolveAllRemaining();
+		EXPECT_TRUE(errors.empty());
+		CompareTokens(tokens, expectedTokens);
+	}
+}
+
+TEST_F(LexerTest, CommentLengthLimitCountsCharacters)
+{
+	const auto errorsFor = [](const std::string& utf8Comment)
+	{
+		const std::string code = "#" + utf8Comment + "\nx";
+		Lexer lexer(std::string_view{ code });
+		const auto [tokens, errors] = lexer.ResolveAllRemaining();
+		EXPECT_EQ(tokens.size(), 3);
+		EXPECT_EQ(tokens[1].GetPosition().line, 2);
+		return errors.size();
+	};
+	std::string polishLetters;
+	for (int i = 0; i < 500; ++i)
+	{
+		polishLetters += "\xC5\xBC";
+	}
+	EXPECT_EQ(errorsFor(std::string(500, '.')), 0);
+	EXPECT_EQ(errorsFor(std::string(501, '.')), 1);
+	// Twice as many bytes as characters, still within the limit
+	EXPECT_EQ(errorsFor(polishLetters), 0);
+	EXPECT_EQ(errorsFor(polishLetters + "."), 1);
+
+	std::wstringstream stream(L"#" + std::wstring(500, L'.') + L"\n#" + std::wstring(501, L'.'));
+	Lexer streamLexer(&stream);
+	const auto [tokens, errors] = streamLexer.ResolveAllRemaining();
+	ASSERT_EQ(errors.size(), 1);
+	EXPECT_EQ(errors[0].GetType(), LexicalError::ErrorType::CommentTooLong);
+	EXPECT_EQ(errors[0].GetPosition().line, 2);
+}
+
+TEST_F(LexerTest, StringLiteralRunsStopAtEscapesAndLimit)
+{
+	// Escapes right before, at and after vector boundaries
+	std::wstring code;
+	std::vector<std::wstring> expectedTexts;
+	for (size_t offset = 14; offset < 35; ++offset)
+	{
+		code += L"\"" + std::wstring(offset, L'a') + L"\\tb\" ";
+		expectedTexts.push_back(std::wstring(offset, L'a') + L"\tb");
+	}
+	code += L"\"" + std::wstring(300, L'c') + L"\" \"" + std::wstring(320, L'd') + L"\" \"za\u017C\u00F3\u0142\u0107\"";
+	expectedTexts.push_back(std::wstring(300, L'c'));
+	expectedTexts.push_back(L"");
+	expectedTexts.push_back(L"za\u017C\u00F3\u0142\u0107");
+
+	std::wstringstream stream(code);
+	Lexer streamLexer(&stream);
+	const auto [tokens, errors] = streamLexer.ResolveAllRemaining();
+	ASSERT_EQ(tokens.size(), expectedTexts.size() + 1);
+	for (size_t i = 0; i < expectedTexts.size(); ++i)
+	{
+		if (i == expectedTexts.size() - 2)
+		{
+			EXPECT_EQ(tokens[i].GetType(), LexToken::TokenType::Unrecognized);
+			continue;
+		}
+		EXPECT_EQ(tokens[i].GetType(), LexToken::TokenType::String);
+		EXPECT_EQ(tokens[i].GetText(), expectedTexts[i]);
+	}
+	ASSERT_EQ(errors.size(), 1);
+	EXPECT_EQ(errors[0].GetType(), LexicalError::ErrorType::StringLiteralTooLong);
+
+	// All characters of the code fit into at most two UTF-8 bytes
+	std::string utf8Code;
+	for (const wchar_t character : code)
+	{
+		if (character < 0x80)
+		{
+			utf8Code += static_cast<char>(character);
+		}
+		else
+		{
+			utf8Code += static_cast<char>(0xC0 | (character >> 6));
+			utf8Code += static_cast<char>(0x80 | (character & 0x3F));
+		}
+	}
+	Lexer utf8Lexer(std::string_view{ utf8Code });
+	const auto [utf8Tokens, utf8Errors] = utf8Lexer.ResolveAllRemaining();
+	CompareTokens(utf8Tokens, tokens);
+	EXPECT_EQ(utf8Errors.size(), 1);
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "ParallelParser.h"
+#include "Parser.h"
+#include "ComparePrograms.h"
+
+static std::unique_ptr<Program> ParseSequentially(const std::wstring& code)
+{
+	Lexer lexer(std::wstring_view{ code });
+	const auto tokens = lexer.Tokenize();
+	Parser parser(&tokens);
+	return parser.ParseProgram();
+}
+
+// Functions with nested blocks, function literals, comments and string literals spanning lines
+static std::wstring GenerateFunctions(const size_t count)
+{
+	std::wstring code = L"# generated functions }\n";
+	for (size_t i = 0; i < count; ++i)
+	{
+		const auto name = L"F" + std::to_wstring(i);
+		code += L"func " + name + L"(mut a, b)\n{\n\tif (a > b) { a = b; } # }\n";
+		code += L"\tvar text = \"{ multi\nline }\";\n";
+		code += L"\tvar f = [" + name + L" << (1)];\n";
+		code += L"\treturn a + b * " + std::to_wstring(i) + L";\n}";
+		code += i % 3 == 0 ? L" # after\n\n" : L"\n";
+	}
+	return code;
+}
+
+static void ComparePositions(const Program* const program, const Program* const expectedProgram)
+{
+	ASSERT_EQ(program->funDefs.size(), expectedProgram->funDefs.size());
+	for (size_t i = 0; i < program->funDefs.size(); ++i)
+	{
+		const auto& funDef = *program->funDefs[i];
+		const auto& expectedFunDef = *expectedProgram->funDefs[i];
+		EXPECT_EQ(funDef.startingPosition.line, expectedFunDef.startingPosition.line);
+		EXPECT_EQ(funDef.startingPosition.column, expectedFunDef.startingPosition.column);
+		const auto& statements = funDef.block->statements;
+		const auto& expectedStatements = expectedFunDef.block->statements;
+		ASSERT_EQ(statements.size(), expectedStatements.size());
+		for (size_t j = 0; j < statements.size(); ++j)
+		{
+			EXPECT_EQ(statements[j]->startingPosition.line, expectedStatements[j]->startingPosition.line);
+			EXPECT_EQ(statements[j]->startingPosition.column, expectedStatements[j]->startingPosition.column);
+		}
+	}
+}
+
+TEST(ParallelParserTests, SplitsAfterTopLevelFunctionsOnly)
+{
+	const std::wstring code =
+		L"func A() { var f = [B << (1)]; } # }\n"
+		L"func B(x) { return \"}\n\"; }\n"
+		L"\n"
+		L"func C() {} func D() {}\n"
+		L"func E() {\n}";
+	const auto chunks = ParallelParser::Split(std::wstring_view{ code });
+
+	ASSERT_EQ(chunks.size(), 4);
+	EXPECT_EQ(chunks[0].start.line, 1);
+	EXPECT_EQ(chunks[1].start.line, 2);
+	// Newline inside the string literal is not counted
+	EXPECT_EQ(chunks[2].start.line, 3);
+	EXPECT_EQ(chunks[3].start.line, 5);
+	EXPECT_EQ(code.substr(chunks[3].begin, 4), L"func");
+	EXPECT_EQ(chunks[3].end, code.size());
+	for (const auto& chunk : chunks)
+	{
+		EXPECT_EQ(chunk.start.column, 1);
+	}
+}
+
+TEST(ParallelParserTests, UnbalancedBracesAreNotSplit)
+{
+	EXPECT_TRUE(ParallelParser::Split(std::wstring_view{ L"func A() { }}\nfunc B() {}" }).empty());
+	EXPECT_TRUE(ParallelParser::Split(std::wstring_view{ L"func A() { \"}\n" }).empty());
+}
+
+TEST(ParallelParserTests, ProgramMatchesSequentialParse)
+{
+	const auto code = GenerateFunctions(300);
+	const auto expectedProgram = ParseSequentially(code);
+	ASSERT_EQ(expectedProgram->funDefs.size(), 300);
+
+	const auto program = ParallelParser(4).ParseProgram(std::wstring_view{ code });
+	ComparePrograms(program.get(), expectedProgram.get());
+	ComparePositions(program.get(), expectedProgram.get());
+	// Seven lines per function, first one follows the comment and has an empty line after it
+	EXPECT_EQ(program->funDefs[1]->startingPosition.line, 10);
+	EXPECT_EQ(program->funDefs[1]->startingPosition.column, 1);
+
+	const std::string utf8Code(code.begin(), code.end());
+	const auto utf8Program = ParallelParser(3).ParseProgram(std::string_view{ utf8Code });
+	ComparePrograms(utf8Program.get(), expectedProgram.get());
+	ComparePositions(utf8Program.get(), expectedProgram.get());
+}
+
+TEST(ParallelParserTests, SyntaxErrorFallsBackToSequentialParse)
+{
+	auto code = GenerateFunctions(100);
+	code.replace(code.find(L"func F57"), 4, L"fun");
+	const auto expectedProgram = ParseSequentially(code);
+	ASSERT_EQ(expectedProgram->funDefs.size(), 57);
+
+	const auto program = ParallelParser(4).ParseProgram(std::wstring_view{ code });
+	ComparePrograms(program.get(), expectedProgram.get());
+	ComparePositions(program.get(), expectedProgram.get());
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include "Parser.h"
+#include "ParseCache.h"
+#include "ProgramImage.h"
+#include "ComparePrograms.h"
+
+static const std::string cachedCode = R"(
+func Main()
+{
+	mut var i = 0;
+	while (i < 3) { i = i + 1; }
+}
+)";
+
+static std::unique_ptr<Program> ParseProgram(const std::string& code)
+{
+	Lexer lexer(std::string_view{ code });
+	const auto tokens = lexer.Tokenize();
+	Parser parser(&tokens);
+	return parser.ParseProgram();
+}
+
+class ParseCacheTests : public testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		std::filesystem::remove_all(directory);
+	}
+
+	void TearDown() override
+	{
+		std::filesystem::remove_all(directory);
+	}
+
+	const std::filesystem::path directory = std::filesystem::temp_directory_path() / "InterpreterParseCacheTest";
+};
+
+TEST_F(ParseCacheTests, StoredProgramIsLoadedByLaterRuns)
+{
+	const auto program = ParseProgram(cachedCode);
+	ParseCache firstRun(directory);
+	EXPECT_EQ(firstRun.Load(cachedCode), nullptr);
+	ASSERT_TRUE(firstRun.Store(*program, cachedCode));
+
+	ParseCache secondRun(directory);
+	const auto loaded = secondRun.Load(cachedCode);
+	ASSERT_NE(loaded, nullptr);
+	ComparePrograms(loaded.get(), program.get());
+
+	EXPECT_EQ(firstRun.GetStatistics().hits, 0);
+	EXPECT_EQ(firstRun.GetStatistics().misses, 1);
+	EXPECT_EQ(secondRun.GetStatistics().hits, 1);
+	EXPECT_EQ(secondRun.GetStatistics().misses, 0);
+	const auto totals = secondRun.ReadTotalStatistics();
+	EXPECT_EQ(totals.hits, 1);
+	EXPECT_EQ(totals.misses, 1);
+}
+
+TEST_F(ParseCacheTests, ChangedSourceMisses)
+{
+	ParseCache cache(directory);
+	ASSERT_TRUE(cache.Store(*ParseProgram(cachedCode), cachedCode));
+
+	const auto changedCode = cachedCode + "\n";
+	EXPECT_EQ(cache.Load(changedCode), nullptr);
+	EXPECT_NE(cache.Load(cachedCode), nullptr);
+	EXPECT_EQ(std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator()), 2);
+
+	// Image stored under the name of other source is rejected by its header
+	std::filesystem::copy_file(cache.GetImagePath(ProgramImage::HashSource(cachedCode)), cache.GetImagePath(ProgramImage::HashSource(changedCode)));
+	EXPECT_EQ(cache.Load(changedCode), nullptr);
+	EXPECT_EQ(cache.GetStatistics().misses, 2);
+}
@@ -616,4 +616,54 @@ TEST_F(ParserTest, FunctionExpressionWithComposition)
 	exFunDefs.push_back(std::move(exFunDef));
 	expectedProgram.funDefs = std::move(exFunDefs);
 	ComparePrograms(program.get(), &expectedProgram);
-}
\ No newline at end of file
+}
+TEST_F(ParserTest, TokenBufferParsesSameProgram)
+{
+	const std::wstring code = L"func Fizz(mut a, b)\n{ # comment\nvar c = a * (b + 2) >= 3 || !false;\nwhile (c) { c = Buzz(a, \"text\"); }\nreturn [Fizz << (3) >> (x) { return x; }];\n}\nfunc Buzz() { return; }";
+	std::wstringstream input(code);
+	auto streamLexer = Lexer(&input);
+	Parser streamParser = Parser(&streamLexer);
+	const auto expectedProgram = streamParser.ParseProgram();
+
+	auto batchLexer = Lexer(std::wstring_view{ code });
+	const auto tokens = batchLexer.Tokenize();
+	Parser bufferParser = Parser(&tokens);
+	const auto program = bufferParser.ParseProgram();
+
+	ASSERT_EQ(expectedProgram->funDefs.size(), 2);
+	ComparePrograms(program.get(), expectedProgram.get());
+}
+
+TEST_F(ParserTest, TokenBufferReportsSameCommentErrors)
+{
+	const std::wstring code = L"func Fizz()\n{\n#" + std::wstring(550, L'-') + L"\nreturn;\n}";
+	std::wstringstream input(code);
+	auto streamLexer = Lexer(&input);
+	Parser streamParser = Parser(&streamLexer);
+	testing::internal::CaptureStdout();
+	streamParser.ParseProgram();
+	const auto streamOutput = testing::internal::GetCapturedStdout();
+
+	auto batchLexer = Lexer(std::wstring_view{ code });
+	const auto tokens = batchLexer.Tokenize();
+	Parser bufferParser = Parser(&tokens);
+	testing::internal::CaptureStdout();
+	bufferParser.ParseProgram();
+	const auto bufferOutput = testing::internal::GetCapturedStdout();
+
+	EXPECT_NE(streamOutput.find("Lexical Error [line: 3, column : 1] Comment too long."), std::string::npos);
+	EXPECT_EQ(streamOutput, bufferOutput);
+	EXPECT_TRUE(streamParser.HadErrors());
+}
+
+TEST_F(ParserTest, TokenBufferStopsOnTerminatingError)
+{
+	const std::wstring code = L"func Fizz() { var a = " + std::wstring(300, L'1') + L"; }";
+	auto lexer = Lexer(std::wstring_view{ code });
+	const auto tokens = lexer.Tokenize();
+	Parser parser = Parser(&tokens);
+
+	EXPECT_FALSE(tokens.IsComplete());
+	const auto program = parser.ParseProgram();
+	EXPECT_TRUE(program->funDefs.empty());
+}
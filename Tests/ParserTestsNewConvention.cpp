@@ -192,7 +192,7 @@ TEST_F(ParserTestNewConvention, ParseBindable_ValidIdentifier)
 	ParserTest parser = ParserTest(&lexer);
 	auto bindable = parser.ParseBindable();
 	ASSERT_NE(bindable, nullptr);
-	auto* identifier = std::get_if<std::wstring>(&bindable->bindable);
+	auto* identifier = std::get_if<Symbol>(&bindable->bindable);
 	ASSERT_NE(identifier, nullptr);
 	EXPECT_EQ(*identifier, L"foo");
 }
@@ -205,6 +205,41 @@ TEST_F(ParserTestNewConvention, ParseBindable_InvalidSyntax)
 	EXPECT_THROW(parser.ParseBindable(), ParserTest::ParserException);
 }
 
+TEST_F(ParserTestNewConvention, ParseBindable_ParenthesizedFuncExpression)
+{
+	std::wstringstream input(L"(foo >> bar)");
+	auto lexer = Lexer(&input);
+	ParserTest parser = ParserTest(&lexer);
+	auto bindable = parser.ParseBindable();
+	ASSERT_NE(bindable, nullptr);
+	auto* funcExpression = std::get_if<std::unique_ptr<FuncExpression>>(&bindable->bindable);
+	ASSERT_NE(funcExpression, nullptr);
+	EXPECT_EQ((*funcExpression)->composables.size(), 2);
+}
+
+TEST_F(ParserTestNewConvention, ParseBindable_ParenthesizedIdentifier)
+{
+	std::wstringstream input(L"(foo) >> bar");
+	auto lexer = Lexer(&input);
+	ParserTest parser = ParserTest(&lexer);
+	auto bindable = parser.ParseBindable();
+	ASSERT_NE(bindable, nullptr);
+	EXPECT_NE(std::get_if<std::unique_ptr<FuncExpression>>(&bindable->bindable), nullptr);
+	EXPECT_TRUE(parser.CheckToken(LexToken::TokenType::FunctionCompose));
+}
+
+TEST_F(ParserTestNewConvention, ParseBindable_FunctionLiteralWithSingleParameter)
+{
+	std::wstringstream input(L"(foo) {}");
+	auto lexer = Lexer(&input);
+	ParserTest parser = ParserTest(&lexer);
+	auto bindable = parser.ParseBindable();
+	ASSERT_NE(bindable, nullptr);
+	auto* functionLit = std::get_if<std::unique_ptr<FunctionLiteral>>(&bindable->bindable);
+	ASSERT_NE(functionLit, nullptr);
+	EXPECT_EQ((*functionLit)->parameters.size(), 1);
+}
+
 TEST_F(ParserTestNewConvention, ParseComposable_ValidBindable)
 {
 	std::wstringstream input(L"foo");
@@ -213,7 +248,7 @@ TEST_F(ParserTestNewConvention, ParseComposable_ValidBindable)
 	auto composable = parser.ParseComposable();
 	ASSERT_NE(composable, nullptr);
 	ASSERT_NE(composable->bindable, nullptr);
-	auto* identifier = std::get_if<std::wstring>(&composable->bindable->bindable);
+	auto* identifier = std::get_if<Symbol>(&composable->bindable->bindable);
 	ASSERT_NE(identifier, nullptr);
 	EXPECT_EQ(*identifier, L"foo");
 	EXPECT_TRUE(composable->arguments.empty());
@@ -227,13 +262,13 @@ TEST_F(ParserTestNewConvention, ParseComposable_ValidBindableWithArguments)
 	auto composable = parser.ParseComposable();
 	ASSERT_NE(composable, nullptr);
 	ASSERT_NE(composable->bindable, nullptr);
-	auto* identifier = std::get_if<std::wstring>(&composable->bindable->bindable);
+	auto* identifier = std::get_if<Symbol>(&composable->bindable->bindable);
 	ASSERT_NE(identifier, nullptr);
 	EXPECT_EQ(*identifier, L"foo");
 	ASSERT_EQ(composable->arguments.size(), 2);
 	auto* arg1 = dynamic_cast<StandardExpression*>(composable->arguments[0].get());
 	ASSERT_NE(arg1, nullptr);
-	auto* arg1Literal = std::get_if<std::wstring>(&arg1->conjunctions[0]->relations[0]->firstAdditive->multiplicatives[0]->factors[0]->factor);
+	auto* arg1Literal = std::get_if<Symbol>(&arg1->conjunctions[0]->relations[0]->firstAdditive->multiplicatives[0]->factors[0]->factor);
 	EXPECT_EQ(*arg1Literal, L"bar");
 
 	auto* arg2 = dynamic_cast<StandardExpression*>(composable->arguments[1].get());
@@ -270,7 +305,7 @@ TEST_F(ParserTestNewConvention, ParseFuncExpression_ValidSingleComposable)
 	ASSERT_EQ(funcExpression->composables.size(), 1);
 	auto* composable = funcExpression->composables[0].get();
 	ASSERT_NE(composable, nullptr);
-	auto* identifier = std::get_if<std::wstring>(&composable->bindable->bindable);
+	auto* identifier = std::get_if<Symbol>(&composable->bindable->bindable);
 	ASSERT_NE(identifier, nullptr);
 	EXPECT_EQ(*identifier, L"foo");
 }
@@ -286,13 +321,13 @@ TEST_F(ParserTestNewConvention, ParseFuncExpression_ValidComposableChain)
 
 	auto* composable1 = funcExpression->composables[0].get();
 	ASSERT_NE(composable1, nullptr);
-	auto* identifier1 = std::get_if<std::wstring>(&composable1->bindable->bindable);
+	auto* identifier1 = std::get_if<Symbol>(&composable1->bindable->bindable);
 	ASSERT_NE(identifier1, nullptr);
 	EXPECT_EQ(*identifier1, L"foo");
 
 	auto* composable2 = funcExpression->composables[1].get();
 	ASSERT_NE(composable2, nullptr);
-	auto* identifier2 = std::get_if<std::wstring>(&composable2->bindable->bindable);
+	auto* identifier2 = std::get_if<Symbol>(&composable2->bindable->bindable);
 	ASSERT_NE(identifier2, nullptr);
 	EXPECT_EQ(*identifier2, L"bar");
 }
@@ -308,13 +343,13 @@ TEST_F(ParserTestNewConvention, ParseFuncExpression_ValidComposableWithArguments
 
 	auto* composable1 = funcExpression->composables[0].get();
 	ASSERT_NE(composable1, nullptr);
-	auto* identifier1 = std::get_if<std::wstring>(&composable1->bindable->bindable);
+	auto* identifier1 = std::get_if<Symbol>(&composable1->bindable->bindable);
 	ASSERT_NE(identifier1, nullptr);
 	EXPECT_EQ(*identifier1, L"foo");
 	ASSERT_EQ(composable1->arguments.size(), 2);
 	auto* arg1 = dynamic_cast<StandardExpression*>(composable1->arguments[0].get());
 	ASSERT_NE(arg1, nullptr);
-	auto* arg1Literal = std::get_if<std::wstring>(&arg1->conjunctions[0]->relations[0]->firstAdditive->multiplicatives[0]->factors[0]->factor);
+	auto* arg1Literal = std::get_if<Symbol>(&arg1->conjunctions[0]->relations[0]->firstAdditive->multiplicatives[0]->factors[0]->factor);
 	EXPECT_EQ(*arg1Literal, L"bar");
 
 	auto* arg2 = dynamic_cast<StandardExpression*>(composable1->arguments[1].get());
@@ -325,7 +360,7 @@ TEST_F(ParserTestNewConvention, ParseFuncExpression_ValidComposableWithArguments
 
 	auto* composable2 = funcExpression->composables[1].get();
 	ASSERT_NE(composable2, nullptr);
-	auto* identifier2 = std::get_if<std::wstring>(&composable2->bindable->bindable);
+	auto* identifier2 = std::get_if<Symbol>(&composable2->bindable->bindable);
 	ASSERT_NE(identifier2, nullptr);
 	EXPECT_EQ(*identifier2, L"baz");
 }
@@ -452,6 +487,14 @@ TEST_F(ParserTestNewConvention, ParseFactor_ValidExpression)
 	EXPECT_EQ(std::get<int>(literal->value), 42);
 }
 
+TEST_F(ParserTestNewConvention, ParseFactor_EmptyParentheses)
+{
+	std::wstringstream input(L"()");
+	auto lexer = Lexer(&input);
+	ParserTest parser = ParserTest(&lexer);
+	EXPECT_THROW(parser.ParseFactor(), ParserTest::ParserException);
+}
+
 TEST_F(ParserTestNewConvention, ParseFactor_InvalidSyntax)
 {
 	std::wstringstream input(L"!");
@@ -546,13 +589,13 @@ TEST_F(ParserTestNewConvention, ParseExpression_ValidFuncExpression)
 
 	auto* composable1 = funcExpression->composables[0].get();
 	ASSERT_NE(composable1, nullptr);
-	auto* identifier1 = std::get_if<std::wstring>(&composable1->bindable->bindable);
+	auto* identifier1 = std::get_if<Symbol>(&composable1->bindable->bindable);
 	ASSERT_NE(identifier1, nullptr);
 	EXPECT_EQ(*identifier1, L"foo");
 
 	auto* composable2 = funcExpression->composables[1].get();
 	ASSERT_NE(composable2, nullptr);
-	auto* identifier2 = std::get_if<std::wstring>(&composable2->bindable->bindable);
+	auto* identifier2 = std::get_if<Symbol>(&composable2->bindable->bindable);
 	ASSERT_NE(identifier2, nullptr);
 	EXPECT_EQ(*identifier2, L"bar");
 }
@@ -634,6 +677,44 @@ TEST_F(ParserTestNewConvention, ParseStandardExpression_InvalidSyntax)
 	EXPECT_THROW(parser.ParseStandardExpression(), ParserTest::ParserException);
 }
 
+TEST_F(ParserTestNewConvention, ParseStandardExpression_MixedPrecedence)
+{
+	std::wstringstream input(L"-1 * 2 + 3 < 4 && 5 == 6 || !7");
+	auto lexer = Lexer(&input);
+	ParserTest parser = ParserTest(&lexer);
+	auto standardExpression = parser.ParseStandardExpression();
+	ASSERT_NE(standardExpression, nullptr);
+	ASSERT_EQ(standardExpression->conjunctions.size(), 2);
+
+	auto* conjunction = standardExpression->conjunctions[0].get();
+	ASSERT_EQ(conjunction->relations.size(), 2);
+	auto* relation = conjunction->relations[0].get();
+	EXPECT_EQ(relation->relationOperator, RelationOperator::Less);
+	ASSERT_NE(relation->secondAdditive, nullptr);
+	auto* additive = relation->firstAdditive.get();
+	ASSERT_NE(additive, nullptr);
+	EXPECT_TRUE(additive->negated);
+	ASSERT_EQ(additive->multiplicatives.size(), 2);
+	EXPECT_EQ(additive->operators, std::vector<AdditionOperator>{ AdditionOperator::Plus });
+	EXPECT_EQ(additive->multiplicatives[0]->factors.size(), 2);
+	EXPECT_EQ(additive->multiplicatives[0]->operators, std::vector<MultiplicationOperator>{ MultiplicationOperator::Multiply });
+	EXPECT_EQ(conjunction->relations[1]->relationOperator, RelationOperator::Equal);
+
+	auto* lastFactor = standardExpression->conjunctions[1]->relations[0]->firstAdditive->multiplicatives[0]->factors[0].get();
+	EXPECT_TRUE(lastFactor->logicallyNegated);
+}
+
+TEST_F(ParserTestNewConvention, ParseRelation_SecondRelationOperatorLeftUnconsumed)
+{
+	std::wstringstream input(L"1 < 2 < 3");
+	auto lexer = Lexer(&input);
+	ParserTest parser = ParserTest(&lexer);
+	auto relation = parser.ParseRelation();
+	ASSERT_NE(relation, nullptr);
+	EXPECT_EQ(relation->relationOperator, RelationOperator::Less);
+	EXPECT_TRUE(parser.CheckToken(LexToken::TokenType::Less));
+}
+
 TEST_F(ParserTestNewConvention, ParseConjunction_ValidSingleRelation)
 {
 	std::wstringstream input(L"42");
@@ -1316,12 +1397,25 @@ TEST_F(ParserTestNewConvention, GetNextToken_ReuseLastToken)
 	auto lexer = Lexer(&input);
 	ParserTest parser = ParserTest(&lexer);
 	auto token1 = parser.GetNextToken();
-	parser.lastUnusedToken = token1;
+	parser.PushBackToken(token1);
 	auto token2 = parser.GetNextToken();
 	EXPECT_EQ(token2.GetType(), LexToken::TokenType::Integer);
 	EXPECT_EQ(std::get<int>(token2.GetValue()), 42);
 }
 
+TEST_F(ParserTestNewConvention, PeekToken_DoesNotConsume)
+{
+	std::wstringstream input(L"a = 42;");
+	auto lexer = Lexer(&input);
+	ParserTest parser = ParserTest(&lexer);
+	EXPECT_EQ(parser.PeekToken(2).GetType(), LexToken::TokenType::Integer);
+	EXPECT_EQ(parser.PeekToken().GetType(), LexToken::TokenType::Identifier);
+	EXPECT_EQ(parser.GetNextToken().GetType(), LexToken::TokenType::Identifier);
+	EXPECT_EQ(parser.PeekToken(2).GetType(), LexToken::TokenType::Semicolon);
+	EXPECT_TRUE(parser.ConsumeToken(LexToken::TokenType::Assign));
+	EXPECT_EQ(std::get<int>(parser.GetNextToken().GetValue()), 42);
+}
+
 TEST_F(ParserTestNewConvention, GetExpectedToken_ValidToken)
 {
 	std::wstringstream input(L"42");
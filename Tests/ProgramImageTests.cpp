@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include "Parser.h"
+#include "Interpreter.h"
+#include "ProgramImage.h"
+#include "TraceOutput.h"
+#include "ComparePrograms.h"
+
+// Every kind of statement, expression and literal the image stores
+static const std::wstring imageCode = LR"(
+func Add(a, mut b)
+{
+	b = b + a;
+	return b;
+}
+
+func NeverCalled(flag)
+{
+	var wide = "zażółć gęślą";
+	if (flag != 0) { }
+	return;
+}
+
+func Main()
+{
+	var text = "quoted \"text\"";
+	mut var i = -3;
+	var f = 2.5;
+	var composed = [(x) { return x * 2; } >> (y) { return y; }];
+	var addOne = [Add << (1)];
+	var twice = [(composed) >> composed];
+	while (i < 3 && !(i == 10) || false)
+	{
+		i = i + 1;
+		if (i >= 2) { Add(i, 1); } else { mut var empty; }
+	}
+	{
+		var nested = composed(f) / 2 - Add(-(i - 1), 4) + addOne(2) + twice(1);
+	}
+}
+)";
+
+static std::unique_ptr<Program> ParseProgram(const std::wstring& code)
+{
+	Lexer lexer(std::wstring_view{ code });
+	const auto tokens = lexer.Tokenize();
+	Parser parser(&tokens);
+	return parser.ParseProgram();
+}
+
+static std::string InterpretWithOutput(const Program* const program)
+{
+	Interpreter interpreter;
+	return InterpretWithOutput(interpreter, program);
+}
+
+TEST(ProgramImageTests, LoadedProgramMatchesParsedOne)
+{
+	const auto program = ParseProgram(imageCode);
+	ASSERT_EQ(program->funDefs.size(), 3);
+	const auto sourceHash = ProgramImage::HashSource(imageCode);
+	const auto image = ProgramImage::Serialize(*program, sourceHash);
+
+	const auto loaded = ProgramImage::Deserialize(image.data(), image.size(), sourceHash);
+	ASSERT_NE(loaded, nullptr);
+	ComparePrograms(loaded.get(), program.get());
+
+	const auto& statement = loaded->funDefs[2]->block->statements[1];
+	const auto& expectedStatement = program->funDefs[2]->block->statements[1];
+	EXPECT_EQ(statement->startingPosition.line, expectedStatement->startingPosition.line);
+	EXPECT_EQ(statement->startingPosition.column, expectedStatement->startingPosition.column);
+	if (Tracer::compiledIn)
+	{
+		EXPECT_EQ(InterpretWithOutput(loaded.get()), InterpretWithOutput(program.get()));
+	}
+}
+
+TEST(ProgramImageTests, StaleOrDamagedImageIsRejected)
+{
+	const auto program = ParseProgram(imageCode);
+	const auto sourceHash = ProgramImage::HashSource(imageCode);
+	auto image = ProgramImage::Serialize(*program, sourceHash);
+
+	EXPECT_EQ(ProgramImage::Deserialize(image.data(), image.size(), ProgramImage::HashSource(imageCode + L" ")), nullptr);
+	EXPECT_EQ(ProgramImage::Deserialize(image.data(), image.size() - 1, sourceHash), nullptr);
+	EXPECT_EQ(ProgramImage::Deserialize(image.data(), 10, sourceHash), nullptr);
+
+	auto otherVersion = image;
+	otherVersion[4] ^= 0xFF;
+	EXPECT_EQ(ProgramImage::Deserialize(otherVersion.data(), otherVersion.size(), sourceHash), nullptr);
+
+	image[image.size() / 2] ^= 0x01;
+	EXPECT_EQ(ProgramImage::Deserialize(image.data(), image.size(), sourceHash), nullptr);
+}
+
+TEST(ProgramImageTests, WrittenFileIsLoaded)
+{
+	const auto program = ParseProgram(imageCode);
+	const auto sourceHash = ProgramImage::HashSource(imageCode);
+	const auto path = (std::filesystem::temp_directory_path() / "InterpreterProgramImageTest.bin").string();
+
+	ASSERT_TRUE(ProgramImage::Write(*program, sourceHash, path));
+	const auto loaded = ProgramImage::Load(path, sourceHash);
+	std::filesystem::remove(path);
+	ASSERT_NE(loaded, nullptr);
+	ComparePrograms(loaded.get(), program.get());
+	EXPECT_EQ(ProgramImage::Load(path, sourceHash), nullptr);
+}
+
+TEST(ProgramImageTests, FailedWriteLeavesNoFiles)
+{
+	const auto program = ParseProgram(imageCode);
+	const auto directory = std::filesystem::temp_directory_path() / "InterpreterProgramImageWriteTest";
+	std::filesystem::remove_all(directory);
+	// Image can not be renamed over a directory which is not empty
+	const auto path = directory / "image";
+	std::filesystem::create_directories(path / "content");
+
+	EXPECT_FALSE(ProgramImage::Write(*program, ProgramImage::HashSource(imageCode), path.string()));
+	EXPECT_EQ(std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator()), 1);
+	std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include "Interpreter.h"
+#include <ParserImpl.h>
+#include "TraceOutput.h"
+
+static std::unique_ptr<Program> ParseStringAsProgram(const std::wstring& input) {
+	std::wstringstream inputStream(input);
+	Lexer lexer(&inputStream);
+	ParserImpl parser(&lexer);
+	return parser.ParseProgram();
+}
+
+static const Factor* GetSingleFactor(const Expression* const expression) {
+	auto standardExpression = dynamic_cast<const StandardExpression*>(expression);
+	return standardExpression->conjunctions.front()->relations.front()->firstAdditive->multiplicatives.front()->factors.front().get();
+}
+
+TEST(ResolverTests, ParametersAndDeclarationsGetSlots) {
+	auto program = ParseStringAsProgram(LR"(
+	func Main(a, b)
+	{
+		var c = b;
+		return c;
+	}
+	)");
+	const auto& statements = program->funDefs.front()->block->statements;
+
+	auto declaration = dynamic_cast<const Declaration*>(statements[0].get());
+	ASSERT_TRUE(declaration->variableSlot.has_value());
+	EXPECT_EQ(declaration->variableSlot->depth, 0);
+	EXPECT_EQ(declaration->variableSlot->slot, 0);
+
+	auto initializer = GetSingleFactor(declaration->expression.get());
+	ASSERT_TRUE(initializer->variableSlot.has_value());
+	EXPECT_EQ(initializer->variableSlot->depth, 1);
+	EXPECT_EQ(initializer->variableSlot->slot, 1);
+
+	auto returnStatement = dynamic_cast<const Return*>(statements[1].get());
+	auto returned = GetSingleFactor(returnStatement->expression.get());
+	ASSERT_TRUE(returned->variableSlot.has_value());
+	EXPECT_EQ(returned->variableSlot->depth, 0);
+	EXPECT_EQ(returned->variableSlot->slot, 0);
+}
+
+TEST(ResolverTests, NestedBlocksIncreaseDepth) {
+	auto program = ParseStringAsProgram(LR"(
+	func Main()
+	{
+		mut var a = 1;
+		while(a < 3)
+		{
+			var b = 2;
+			a = a + b;
+		}
+		return a;
+	}
+	)");
+	const auto& statements = program->funDefs.front()->block->statements;
+	auto whileLoop = dynamic_cast<const WhileLoop*>(statements[1].get());
+
+	auto condition = whileLoop->condition->conjunctions.front()->relations.front()->firstAdditive->multiplicatives.front()->factors.front().get();
+	ASSERT_TRUE(condition->variableSlot.has_value());
+	EXPECT_EQ(condition->variableSlot->depth, 0);
+
+	auto assignment = dynamic_cast<const Assignment*>(whileLoop->block->statements[1].get());
+	ASSERT_TRUE(assignment->variableSlot.has_value());
+	EXPECT_EQ(assignment->variableSlot->depth, 1);
+	EXPECT_EQ(assignment->variableSlot->slot, 0);
+}
+
+TEST(ResolverTests, RedefinitionAndUndeclaredStayUnresolved) {
+	auto program = ParseStringAsProgram(LR"(
+	func Main(a)
+	{
+		var Buzz = 1;
+		var a = 2;
+		return b;
+	}
+
+	func Buzz()
+	{
+		return 0;
+	}
+	)");
+	const auto& statements = program->funDefs.front()->block->statements;
+	EXPECT_FALSE(dynamic_cast<const Declaration*>(statements[0].get())->variableSlot.has_value());
+	EXPECT_FALSE(dynamic_cast<const Declaration*>(statements[1].get())->variableSlot.has_value());
+	auto returnStatement = dynamic_cast<const Return*>(statements[2].get());
+	EXPECT_FALSE(GetSingleFactor(returnStatement->expression.get())->variableSlot.has_value());
+}
+
+TEST(ResolverTests, FunctionLiteralDoesNotSeeEnclosingVariables) {
+	auto program = ParseStringAsProgram(LR"(
+	func Main()
+	{
+		var a = 1;
+		var e = [(b) { return a + b; }];
+		return e(1);
+	}
+	)");
+	const auto& statements = program->funDefs.front()->block->statements;
+	auto declaration = dynamic_cast<const Declaration*>(statements[1].get());
+	auto funcExpression = dynamic_cast<const FuncExpression*>(declaration->expression.get());
+	const auto& funcLit = std::get<std::unique_ptr<FunctionLiteral>>(funcExpression->composables.front()->bindable->bindable);
+	auto returnStatement = dynamic_cast<const Return*>(funcLit->block->statements.front().get());
+	auto additive = dynamic_cast<const StandardExpression*>(returnStatement->expression.get())->conjunctions.front()->relations.front()->firstAdditive.get();
+
+	EXPECT_FALSE(additive->multiplicatives[0]->factors.front()->variableSlot.has_value());
+	ASSERT_TRUE(additive->multiplicatives[1]->factors.front()->variableSlot.has_value());
+	EXPECT_EQ(additive->multiplicatives[1]->factors.front()->variableSlot->depth, 1);
+	EXPECT_EQ(additive->multiplicatives[1]->factors.front()->variableSlot->slot, 0);
+}
+
+TEST(ResolverTests, CaptureOutput_ResolvedProgram) {
+	if (!Tracer::compiledIn) GTEST_SKIP() << "Tracing is compiled out";
+	auto program = ParseStringAsProgram(LR"(
+	func Main()
+	{
+		mut var a = 0;
+		mut var i = 2;
+		while(i > 0)
+		{
+			var b = i * 2;
+			if(b > 2)
+			{
+				a = a + b;
+			}
+			else
+			{
+				a = a - b;
+			}
+			i = i - 1;
+		}
+		return a;
+	}
+	)");
+
+	Interpreter interpreter;
+	std::string output = InterpretWithTrace(interpreter, program.get());
+
+	std::string expectedOutput = "Function: Main Arguments: \n\tDeclaration a = 0\n\tDeclaration i = 2\n\tWhile true\n\t\tDeclaration b = 4\n\t\tConditional true\n\t\t\tAssignment a = 4\n\t\tAssignment i = 1\n\t\tDeclaration b = 2\n\t\tConditional false\n\t\t\tAssignment a = 2\n\t\tAssignment i = 0\n\tReturn 2\n";
+	EXPECT_EQ(output, expectedOutput);
+}
+
+TEST(ResolverTests, FunctionIdentifiersAreBound) {
+	auto program = ParseStringAsProgram(LR"(
+	func Main()
+	{
+		var e = [Buzz];
+		Fizz(e);
+		return Buzz();
+	}
+
+	func Buzz()
+	{
+		return 1;
+	}
+	)");
+	const auto buzz = program->funDefs[1].get();
+	const auto& statements = program->funDefs.front()->block->statements;
+
+	auto declaration = dynamic_cast<const Declaration*>(statements[0].get());
+	auto funcExpression = dynamic_cast<const FuncExpression*>(declaration->expression.get());
+	EXPECT_EQ(funcExpression->composables.front()->bindable->functionDefinition, buzz);
+
+	auto callStatement = dynamic_cast<const FunctionCallStatement*>(statements[1].get());
+	EXPECT_EQ(callStatement->funcCall->functionDefinition, nullptr);
+
+	auto returnStatement = dynamic_cast<const Return*>(statements[2].get());
+	const auto& funcCall = std::get<std::unique_ptr<FunctionCall>>(GetSingleFactor(returnStatement->expression.get())->factor);
+	EXPECT_EQ(funcCall->functionDefinition, buzz);
+}
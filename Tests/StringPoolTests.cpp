@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include "StringPool.h"
+#include "Interpreter.h"
+#include "Parser.h"
+
+class LiteralInterpreter : public Interpreter
+{
+public:
+	using Interpreter::EvaluateLiteral;
+};
+
+TEST(StringPoolTests, Intern_SharesEqualStrings) {
+	StringPool stringPool;
+	auto first = stringPool.Intern(L"text");
+	auto second = stringPool.Intern(std::wstring(L"te") + L"xt");
+	auto other = stringPool.Intern(L"other");
+
+	EXPECT_EQ(first.Get(), second.Get());
+	EXPECT_NE(first.Get(), other.Get());
+	EXPECT_EQ(other->GetText(), L"other");
+	EXPECT_EQ(stringPool.GetSize(), 2);
+}
+
+TEST(StringPoolTests, Clear_KeepsHandedOutStrings) {
+	StringPool stringPool;
+	auto string = stringPool.Intern(L"text");
+	stringPool.Clear();
+
+	EXPECT_EQ(stringPool.GetSize(), 0);
+	EXPECT_EQ(string->GetText(), L"text");
+	EXPECT_NE(stringPool.Intern(L"text").Get(), string.Get());
+}
+
+TEST(StringPoolTests, EvaluateLiteral_SharesBuffer) {
+	const std::wstring code = L"func Main() { var a = \"literal\"; var b = \"literal\" + 1; }";
+	Lexer lexer(std::wstring_view{ code });
+	const auto tokens = lexer.Tokenize();
+	const auto program = Parser(&tokens).ParseProgram();
+	const auto& statements = program->funDefs.front()->block->statements;
+	const auto& literal = *dynamic_cast<const StandardExpression*>(dynamic_cast<const Declaration*>(statements[0].get())->expression.get())->lowered[0].literal;
+	const auto& sameText = *dynamic_cast<const StandardExpression*>(dynamic_cast<const Declaration*>(statements[1].get())->expression.get())->lowered[0].literal;
+	LiteralInterpreter interpreter;
+
+	const auto first = interpreter.EvaluateLiteral(literal);
+	const auto second = interpreter.EvaluateLiteral(literal);
+	const auto third = interpreter.EvaluateLiteral(sameText);
+
+	ASSERT_NE(first.GetString(), nullptr);
+	EXPECT_EQ(*first.GetString(), L"literal");
+	EXPECT_EQ(first.GetString(), second.GetString());
+	EXPECT_EQ(first.GetString(), third.GetString());
+}
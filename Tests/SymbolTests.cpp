@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include "Symbol.h"
+#include "Lexer.h"
+#include "Parser.h"
+
+TEST(SymbolTests, EqualNamesShareId) {
+	const Symbol first(L"symbolTestName");
+	const Symbol second(std::wstring(L"symbolTest") + L"Name");
+	const Symbol other(L"symbolTestOther");
+
+	EXPECT_EQ(first, second);
+	EXPECT_EQ(first.GetId(), second.GetId());
+	EXPECT_NE(first, other);
+	EXPECT_EQ(&first.GetName(), &second.GetName());
+	EXPECT_TRUE(first == L"symbolTestName");
+	EXPECT_EQ(sizeof(Symbol), sizeof(void*));
+}
+
+TEST(SymbolTests, EmptySymbol) {
+	const Symbol empty;
+	const auto tableSize = Symbol::GetTableSize();
+
+	EXPECT_TRUE(empty.IsEmpty());
+	EXPECT_EQ(empty.GetId(), 0);
+	EXPECT_EQ(empty.GetName(), L"");
+	EXPECT_EQ(Symbol(L""), empty);
+	EXPECT_EQ(Symbol::GetTableSize(), tableSize);
+}
+
+TEST(SymbolTests, LexerInternsIdentifiersOnce) {
+	std::wstringstream code(L"symbolTestVariable symbolTestVariable");
+	Lexer lexer(&code);
+	const auto [tokens, errors] = lexer.ResolveAllRemaining();
+	ASSERT_EQ(tokens.size(), 3);
+
+	const auto first = std::get<Symbol>(tokens[0].GetValue());
+	const auto second = std::get<Symbol>(tokens[1].GetValue());
+	EXPECT_EQ(first, second);
+	EXPECT_EQ(first, Symbol(L"symbolTestVariable"));
+}
+
+TEST(SymbolTests, ParserCarriesSymbolsIntoProgram) {
+	std::wstringstream code(L"func symbolTestFunction(symbolTestParam) { return symbolTestParam; }");
+	Lexer lexer(&code);
+	Parser parser(&lexer);
+	const auto program = parser.ParseProgram();
+	ASSERT_EQ(program->funDefs.size(), 1);
+
+	const auto& funDef = program->funDefs.front();
+	EXPECT_EQ(funDef->identifier, Symbol(L"symbolTestFunction"));
+	ASSERT_EQ(funDef->parameters.size(), 1);
+	EXPECT_EQ(funDef->parameters.front().identifier, Symbol(L"symbolTestParam"));
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "ParserObjects/ParserObjects.h"
+#include "TraceRing.h"
+#include "Tracer.h"
+#include "TraceDecoder.h"
+#include "StringConversion.h"
+
+// Runs the program with tracing enabled and returns the decoded text trace
+template<typename Executor>
+static std::string InterpretWithTrace(Executor& executor, const Program* const program) {
+	TraceRing traceRing;
+	Tracer tracer(traceRing);
+	executor.SetTracer(&tracer);
+	executor.Interpret(program);
+	executor.SetTracer(nullptr);
+	std::vector<uint8_t> records;
+	traceRing.Read(records);
+	return StringConversion::ToNarrow(TraceDecoder::Decode(records));
+}
+
+// Trace followed by everything printed while the program ran, errors are printed with the position they occured at
+template<typename Executor>
+static std::string InterpretWithOutput(Executor& executor, const Program* const program) {
+	testing::internal::CaptureStdout();
+	const auto trace = InterpretWithTrace(executor, program);
+	return trace + testing::internal::GetCapturedStdout();
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include "TraceRing.h"
+#include "Tracer.h"
+#include "TraceDecoder.h"
+
+TEST(TraceTests, Ring_WrapsAroundAndDropsWhenFull) {
+	TraceRing traceRing(10);
+	EXPECT_EQ(traceRing.GetCapacity(), 16);
+
+	const std::vector<uint8_t> record = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+	std::vector<uint8_t> output;
+	EXPECT_TRUE(traceRing.Write(record.data(), record.size()));
+	EXPECT_FALSE(traceRing.Write(record.data(), record.size()));
+	EXPECT_EQ(traceRing.GetDroppedCount(), 1);
+	EXPECT_EQ(traceRing.Read(output), record.size());
+
+	output.clear();
+	EXPECT_TRUE(traceRing.Write(record.data(), record.size()));
+	EXPECT_EQ(traceRing.Read(output), record.size());
+	EXPECT_EQ(output, record);
+}
+
+TEST(TraceTests, Ring_ConsumerThreadReceivesAllRecords) {
+	TraceRing traceRing(1024);
+	constexpr uint32_t recordsCount = 10000;
+	std::vector<uint8_t> received;
+	std::thread consumer([&]()
+	{
+		while (received.size() < recordsCount * sizeof(uint32_t))
+		{
+			traceRing.Read(received);
+		}
+	});
+	for (uint32_t i = 0; i < recordsCount; ++i)
+	{
+		while (!traceRing.Write(reinterpret_cast<const uint8_t*>(&i), sizeof(i)))
+		{
+			std::this_thread::yield();
+		}
+	}
+	consumer.join();
+
+	for (uint32_t i = 0; i < recordsCount; ++i)
+	{
+		uint32_t number;
+		std::memcpy(&number, received.data() + i * sizeof(number), sizeof(number));
+		ASSERT_EQ(number, i);
+	}
+}
+
+TEST(TraceTests, Decode_ReproducesTextTrace) {
+	TraceRing traceRing;
+	Tracer tracer(traceRing);
+	tracer.Event(0, TraceEventType::FunctionEntry, std::wstring(L"Main"), std::vector<Value>{ Value(1), Value(2.5f), Value(std::wstring(L"text")), Value(true) });
+	tracer.Event(1, TraceEventType::Declaration, std::wstring(L"f"), Value(Value::Function(nullptr, {})));
+	tracer.Event(1, TraceEventType::DeclarationWithoutValue, std::wstring(L"a"));
+	tracer.Event(1, TraceEventType::While, Value(false));
+	tracer.Event(2, TraceEventType::FunctionCallStatement);
+	tracer.Event(1, TraceEventType::Return, Value(std::wstring(L"done")));
+	tracer.Event(1, TraceEventType::ReturnWithoutValue);
+
+	std::vector<uint8_t> records;
+	traceRing.Read(records);
+	EXPECT_EQ(TraceDecoder::Decode(records), L"Function: Main Arguments: 1 2.500000 text true \n\tDeclaration f = Function\n\tDeclaration a\n\tWhile false\n\t\tFunctionCallStatement\n\tReturn done\n\tReturn\n");
+}
+
+TEST(TraceTests, Decode_StopsAtTruncatedRecord) {
+	TraceRing traceRing;
+	Tracer tracer(traceRing);
+	tracer.Event(0, TraceEventType::ReturnWithoutValue);
+	tracer.Event(0, TraceEventType::Assignment, std::wstring(L"a"), Value(3));
+
+	std::vector<uint8_t> records;
+	traceRing.Read(records);
+	const auto completeSize = records.size();
+	records.pop_back();
+	std::wostringstream output;
+	EXPECT_LT(TraceDecoder::Decode(records.data(), records.size(), output), completeSize);
+	EXPECT_EQ(output.str(), L"Return\n");
+}
@@ -1,5 +1,6 @@
 #include "gtest/gtest.h"
 #include "Value.h"
+#include <limits>
 
 class ValueTest : public Value
 {
@@ -488,6 +489,29 @@ TEST(ValueTests, TryConvertToFloat_IntString)
 	EXPECT_FLOAT_EQ(result.value(), 42.0f);
 }
 
+TEST(ValueTests, TryConvertToInt_MatchesStoiRules)
+{
+	EXPECT_EQ(ValueTest::TryConvertToInt(L"  -17"), -17);
+	EXPECT_EQ(ValueTest::TryConvertToInt(L"+5"), 5);
+	EXPECT_EQ(ValueTest::TryConvertToInt(L"-2147483648"), std::numeric_limits<int>::min());
+	EXPECT_FALSE(ValueTest::TryConvertToInt(L"2147483648").has_value());
+	EXPECT_FALSE(ValueTest::TryConvertToInt(L"+-5").has_value());
+	EXPECT_FALSE(ValueTest::TryConvertToInt(L"5 ").has_value());
+	EXPECT_FALSE(ValueTest::TryConvertToInt(L"-").has_value());
+	EXPECT_FALSE(ValueTest::TryConvertToInt(L"\u0661").has_value());
+}
+
+TEST(ValueTests, TryConvertToFloat_MatchesStofRules)
+{
+	EXPECT_FLOAT_EQ(ValueTest::TryConvertToFloat(L" -2.5e1").value(), -25.0f);
+	EXPECT_FLOAT_EQ(ValueTest::TryConvertToFloat(L"+.5").value(), 0.5f);
+	EXPECT_FLOAT_EQ(ValueTest::TryConvertToFloat(L"0x10").value(), 16.0f);
+	EXPECT_FALSE(ValueTest::TryConvertToFloat(L"1e100").has_value());
+	EXPECT_FALSE(ValueTest::TryConvertToFloat(L"--1").has_value());
+	EXPECT_FALSE(ValueTest::TryConvertToFloat(L"1.5abc").has_value());
+	EXPECT_FALSE(ValueTest::TryConvertToFloat(L"0x").has_value());
+}
+
 // Test CompareInt
 TEST(ValueTests, CompareInt_Equal)
 {
@@ -708,4 +732,96 @@ TEST(ValueTests, OperatorLeftShift_MultipleArguments)
 	EXPECT_EQ(std::get<int>(funcWithArgs->boundArguments[0].value), 42);
 	EXPECT_EQ(std::get<float>(funcWithArgs->boundArguments[1].value), 3.14f);
 	EXPECT_EQ(std::get<bool>(funcWithArgs->boundArguments[2].value), true);
-}
\ No newline at end of file
+}
+
+TEST(ValueTests, CompactRepresentation)
+{
+	EXPECT_LE(sizeof(Value), 16);
+
+	Value str(std::wstring(L"shared string"));
+	Value copy = str;
+	EXPECT_EQ(str.GetString(), copy.GetString());
+	EXPECT_EQ(*copy.GetString(), L"shared string");
+}
+
+TEST(ValueTests, MixedNumericPairs)
+{
+	Value sum = Value(2) + Value(0.5f);
+	ASSERT_TRUE(std::holds_alternative<float>(sum.value));
+	EXPECT_FLOAT_EQ(std::get<float>(sum.value), 2.5f);
+
+	Value quotient = Value(5.0f) / Value(2);
+	ASSERT_TRUE(std::holds_alternative<float>(quotient.value));
+	EXPECT_FLOAT_EQ(std::get<float>(quotient.value), 2.5f);
+
+	EXPECT_TRUE(Value(3) > Value(2.5f));
+	EXPECT_TRUE(Value(2.0f) == Value(2));
+}
+
+TEST(ValueTests, GreaterThan_StringAndNumber)
+{
+	EXPECT_TRUE(Value(std::wstring(L"12.5")) > Value(3));
+	EXPECT_TRUE(Value(std::wstring(L"12.5")) > Value(3.0f));
+	EXPECT_TRUE(Value(std::wstring(L"7")) > Value(2.5f));
+	EXPECT_FALSE(Value(std::wstring(L"2")) > Value(5));
+	EXPECT_FALSE(Value(std::wstring(L"2.5")) > Value(5.0f));
+	EXPECT_TRUE(Value(5) > Value(std::wstring(L"2")));
+	EXPECT_FALSE(Value(3.0f) > Value(std::wstring(L"12.5")));
+}
+
+TEST(ValueTests, StringData_NumericInterpretation)
+{
+	const Value::StringData intText(std::wstring(L"12"));
+	EXPECT_EQ(intText.AsInt(), 12);
+	EXPECT_FLOAT_EQ(intText.AsFloat().value(), 12.0f);
+	EXPECT_EQ(intText.AsInt(), 12);
+
+	const Value::StringData floatText(std::wstring(L"2.5"));
+	EXPECT_FALSE(floatText.AsInt().has_value());
+	EXPECT_FLOAT_EQ(floatText.AsFloat().value(), 2.5f);
+
+	const Value::StringData word(std::wstring(L"abc"));
+	EXPECT_FALSE(word.AsInt().has_value());
+	EXPECT_FALSE(word.AsFloat().has_value());
+	EXPECT_EQ(word.GetText(), L"abc");
+}
+
+TEST(ValueTests, SharedStringKeepsNumericInterpretation)
+{
+	const Value text(std::wstring(L"21"));
+	const Value copy = text;
+	for (int i = 0; i < 3; ++i)
+	{
+		EXPECT_EQ(std::get<int>((text * Value(2)).value), 42);
+		EXPECT_TRUE(copy == Value(21));
+	}
+}
+
+TEST(ValueTests, AppendAssign_ExtendsUniqueString)
+{
+	Value text(std::wstring(L"ab"));
+	const auto buffer = text.GetString();
+	text += Value(std::wstring(L"cd"));
+	text += Value(true);
+	text += Value(1);
+	EXPECT_EQ(text.GetString(), buffer);
+	EXPECT_EQ(*text.GetString(), L"abcdtrue1");
+}
+
+TEST(ValueTests, AppendAssign_DoesNotModifySharedString)
+{
+	Value text(std::wstring(L"ab"));
+	const Value copy = text;
+	text += Value(std::wstring(L"cd"));
+	EXPECT_EQ(*copy.GetString(), L"ab");
+	EXPECT_EQ(*text.GetString(), L"abcd");
+	EXPECT_NE(text.GetString(), copy.GetString());
+}
+
+TEST(ValueTests, AppendAssign_NumericStringStillAdds)
+{
+	Value number(std::wstring(L"12"));
+	number += Value(3);
+	ASSERT_TRUE(std::holds_alternative<int>(number.value));
+	EXPECT_EQ(std::get<int>(number.value), 15);
+}
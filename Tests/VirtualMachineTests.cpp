@@ -0,0 +1,304 @@
+#include <gtest/gtest.h>
+#include "Interpreter.h"
+#include "VirtualMachine.h"
+#include <ParserImpl.h>
+#include "TraceOutput.h"
+
+static std::unique_ptr<Program> ParseStringAsProgram(const std::wstring& input) {
+	std::wstringstream inputStream(input);
+	Lexer lexer(&inputStream);
+	ParserImpl parser(&lexer);
+	return parser.ParseProgram();
+}
+
+class VirtualMachineTests : public ::testing::Test
+{
+protected:
+	std::string InterpretWithInterpreter(const Program* const program)
+	{
+		Interpreter interpreter;
+		return InterpretWithOutput(interpreter, program);
+	}
+
+	std::string InterpretWithVirtualMachine(const Program* const program)
+	{
+		VirtualMachine virtualMachine;
+		return InterpretWithOutput(virtualMachine, program);
+	}
+
+	void ExpectSameOutput(const std::wstring& programCode)
+	{
+		auto program = ParseStringAsProgram(programCode);
+		const auto expectedOutput = InterpretWithInterpreter(program.get());
+		const auto output = InterpretWithVirtualMachine(program.get());
+		EXPECT_EQ(output, expectedOutput);
+	}
+};
+
+TEST_F(VirtualMachineTests, CaptureOutput_FunctionComposition) {
+	std::wstring programCode = LR"(
+	func Main()
+	{
+		var e = [Buzz];
+		var b = [Buzz >> Fizz];
+		return b(1, 2, 3);
+	}
+
+	func Buzz(a, b, mut c)
+	{
+		var d = a + b + c;
+		return d;
+	}
+
+	func Fizz(a)
+	{
+		var d = a + 10;
+		return d;
+	}
+	)";
+	auto program = ParseStringAsProgram(programCode);
+
+	std::string output = InterpretWithVirtualMachine(program.get());
+
+	std::string expectedOutput = "Function: Main Arguments: \n\tDeclaration e = Function\n\tDeclaration b = Function\n\tFunction from variable, Arguments: 1 2 3 \n\t\tDeclaration d = 6\n\t\tReturn 6\n\tFunction from variable, Arguments: 6 \n\t\tDeclaration d = 16\n\t\tReturn 16\n\tReturn 16\n";
+	EXPECT_EQ(output, expectedOutput);
+}
+
+TEST_F(VirtualMachineTests, CaptureOutput_FunctionBinding) {
+	ExpectSameOutput(LR"(
+    func Main()
+    {
+        var e = [Buzz << (1, 2)];
+        return e(3);
+    }
+
+    func Buzz(a, b, mut c)
+    {
+        var d = a + b + c;
+        return d;
+    }
+    )");
+}
+
+TEST_F(VirtualMachineTests, CaptureOutput_FunctionCompositionAndBinding) {
+	ExpectSameOutput(LR"(
+    func Main()
+    {
+        mut var e = [Buzz << (1, 2)];
+		e = [e >> Fizz];
+        return e(3);
+    }
+
+    func Buzz(a, b, mut c)
+    {
+        var d = a + b + c;
+        return d;
+    }
+
+    func Fizz(e)
+    {
+        var d = e + 10;
+        return d;
+    }
+    )");
+}
+
+TEST_F(VirtualMachineTests, CaptureOutput_FunctionLiteralWithBinding) {
+	ExpectSameOutput(LR"(
+    func Main()
+    {
+        var e = [(a, b) { return a + b; } << (10)];
+        return e(5);
+    }
+    )");
+}
+
+TEST_F(VirtualMachineTests, CaptureOutput_FunctionLiteralWithComposition) {
+	ExpectSameOutput(LR"(
+    func Main()
+    {
+        var e = [(a) { return a + 1; } >> (b) { return b * 2; }];
+        return e(5);
+    }
+    )");
+}
+
+TEST_F(VirtualMachineTests, CaptureOutput_WhileLoopAndConditional) {
+	ExpectSameOutput(LR"(
+	func Fizz()
+	{
+		mut var a;
+		a = false;
+		Buzz(5, 6, 7);
+		return a;
+	}
+
+	func Main()
+	{
+		var d = 20;
+		mut var e = 2;
+		while( e > 0)
+		{
+			mut var a = Fizz();
+			e = e - 1;
+		}
+		if(false)
+		{
+			var f = -123;
+			var b = "123";
+		}
+		else
+		{
+			var c = 0.33;
+		}
+		return 0;
+	}
+
+	func Buzz(a, b, mut c)
+	{
+		var d = a + b + c;
+		return d;
+	}
+	)");
+}
+
+TEST_F(VirtualMachineTests, CaptureOutput_Recursion) {
+	ExpectSameOutput(LR"(
+	func Main()
+	{
+		return Factorial(5);
+	}
+
+	func Factorial(n)
+	{
+		if(n <= 1)
+		{
+			return 1;
+		}
+		else
+		{
+			return n * Factorial(n - 1);
+		}
+	}
+	)");
+}
+
+TEST_F(VirtualMachineTests, CaptureOutput_LogicalAndStringOperations) {
+	ExpectSameOutput(LR"(
+	func Main()
+	{
+		var a = "12" + 3;
+		var b = 3 * "ab";
+		var c = a > 10 and b != "" or false;
+		var d = 7 / 2.0 - 1;
+		return c;
+	}
+	)");
+}
+
+TEST_F(VirtualMachineTests, CaptureOutput_AssignToImmutableVariable) {
+	ExpectSameOutput(LR"(
+	func Main()
+	{
+		var a = 1;
+		a = 2;
+		return a;
+	}
+	)");
+}
+
+TEST_F(VirtualMachineTests, CaptureOutput_WrongArgumentsCount) {
+	ExpectSameOutput(LR"(
+	func Main()
+	{
+		return Buzz(1);
+	}
+
+	func Buzz(a, b)
+	{
+		return a + b;
+	}
+	)");
+}
+
+TEST_F(VirtualMachineTests, CaptureOutput_FunctionDidNotReturnValue) {
+	ExpectSameOutput(L"func Foo() { } func Main() { var a = Foo(); }");
+	ExpectSameOutput(LR"(
+	func Main()
+	{
+		var a = 2 * Foo(1);
+	}
+
+	func Foo(a)
+	{
+		var b = a + 1;
+		if (b > 5) { return b; } else { }
+	}
+	)");
+}
+
+TEST_F(VirtualMachineTests, CaptureOutput_StringComparedWithNumber) {
+	const std::wstring programCode = LR"(
+	func Main()
+	{
+		var a = "12.5" > 3;
+		var b = "2" > 5;
+		var c = "12.5" > 3.5;
+		var d = 5 > "2";
+		var e = "2" < 5;
+	}
+	)";
+	auto program = ParseStringAsProgram(programCode);
+	const auto output = InterpretWithVirtualMachine(program.get());
+	EXPECT_NE(output.find("Declaration a = true\n\tDeclaration b = false\n\tDeclaration c = true\n\tDeclaration d = true\n\tDeclaration e = true"), std::string::npos);
+	ExpectSameOutput(programCode);
+}
+
+TEST_F(VirtualMachineTests, CaptureOutput_MainNotFound) {
+	ExpectSameOutput(LR"(
+	func Buzz(a, b)
+	{
+		return a + b;
+	}
+	)");
+}
+
+TEST_F(VirtualMachineTests, CaptureOutput_SelfAppendingAssignment) {
+	ExpectSameOutput(LR"(
+	func Main()
+	{
+		mut var s = "a";
+		var copy = s;
+		mut var i = 3;
+		while(i > 0)
+		{
+			s = s + i + "-";
+			i = i - 1;
+		}
+		s = s + "|" + s;
+		mut var n = "5";
+		n = n + 1;
+		n = n + true;
+		mut var t = "x";
+		t = t + t;
+		var result = copy + s + n + t;
+		return result;
+	}
+	)");
+}
+
+TEST_F(VirtualMachineTests, Trace_IsOffByDefault) {
+	auto program = ParseStringAsProgram(LR"(
+	func Main()
+	{
+		var a = 1;
+		return a;
+	}
+	)");
+	testing::internal::CaptureStdout();
+	Interpreter interpreter;
+	interpreter.Interpret(program.get());
+	VirtualMachine virtualMachine;
+	virtualMachine.Interpret(program.get());
+	EXPECT_EQ(testing::internal::GetCapturedStdout(), "");
+}
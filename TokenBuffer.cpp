@@ -0,0 +1,58 @@
+#include "TokenBuffer.h"
+
+void TokenBuffer::Push(const LexToken& token)
+{
+	types.push_back(token.GetType());
+	positions.push_back(token.GetPosition());
+	if (std::holds_alternative<std::monostate>(token.GetValue()))
+	{
+		payloadIndices.push_back(noPayload);
+	}
+	else
+	{
+		payloadIndices.push_back(static_cast<uint32_t>(payloads.size()));
+		payloads.push_back(token.GetValue());
+	}
+}
+
+void TokenBuffer::PushError(const LexicalError& error)
+{
+	errors.push_back({ error, types.size() });
+}
+
+size_t TokenBuffer::GetSize() const noexcept
+{
+	return types.size();
+}
+
+LexToken::TokenType TokenBuffer::GetType(const size_t index) const noexcept
+{
+	return types[index];
+}
+
+Position TokenBuffer::GetPosition(const size_t index) const noexcept
+{
+	return positions[index];
+}
+
+const LexToken::TokenValue& TokenBuffer::GetValue(const size_t index) const noexcept
+{
+	static const LexToken::TokenValue noValue;
+	const auto payloadIndex = payloadIndices[index];
+	return (payloadIndex == noPayload) ? noValue : payloads[payloadIndex];
+}
+
+LexToken TokenBuffer::GetToken(const size_t index) const
+{
+	return LexToken(types[index], positions[index], GetValue(index));
+}
+
+const std::vector<TokenBuffer::Error>& TokenBuffer::GetErrors() const noexcept
+{
+	return errors;
+}
+
+bool TokenBuffer::IsComplete() const noexcept
+{
+	return !types.empty() && types.back() == LexToken::TokenType::EndOfFile;
+}
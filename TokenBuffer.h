@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "LexToken.h"
+#include "LexicalError.h"
+
+// Tokens of a whole source kept as parallel arrays, so the parser front end scans them by index.
+// Only tokens carrying a value own an entry in payloads. Lexical errors are kept aside
+// together with index of the token they were reported with.
+class TokenBuffer
+{
+public:
+	struct Error
+	{
+		LexicalError error;
+		size_t tokenIndex;
+	};
+
+	void Push(const LexToken& token);
+	// Error belongs to the token pushed next
+	void PushError(const LexicalError& error);
+
+	size_t GetSize() const noexcept;
+	LexToken::TokenType GetType(const size_t index) const noexcept;
+	Position GetPosition(const size_t index) const noexcept;
+	const LexToken::TokenValue& GetValue(const size_t index) const noexcept;
+	LexToken GetToken(const size_t index) const;
+	const std::vector<Error>& GetErrors() const noexcept;
+	// False when lexing stopped on a terminating error before the end of file
+	bool IsComplete() const noexcept;
+
+private:
+	static constexpr uint32_t noPayload = UINT32_MAX;
+
+	std::vector<LexToken::TokenType> types;
+	std::vector<Position> positions;
+	std::vector<uint32_t> payloadIndices;
+	std::vector<LexToken::TokenValue> payloads;
+	std::vector<Error> errors;
+};
@@ -0,0 +1,29 @@
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+#include "TraceDecoder.h"
+
+// Usage: TraceDecoderTool <trace file>
+int main(int argc, char* argv[])
+{
+	if (argc != 2)
+	{
+		std::cerr << "Usage: TraceDecoderTool <trace file>" << std::endl;
+		return 1;
+	}
+	std::ifstream traceFile(argv[1], std::ios::binary);
+	if (!traceFile.is_open())
+	{
+		std::cerr << "Error opening file!" << std::endl;
+		return 1;
+	}
+	const std::vector<uint8_t> data((std::istreambuf_iterator<char>(traceFile)), std::istreambuf_iterator<char>());
+	const auto consumed = TraceDecoder::Decode(data.data(), data.size(), std::wcout);
+	if (consumed != data.size())
+	{
+		std::cerr << "Trace is truncated or malformed after byte " << consumed << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,208 @@
+#include "TraceDecoder.h"
+#include <cstring>
+#include <sstream>
+
+size_t TraceDecoder::Decode(const uint8_t* const data, const size_t size, std::wostream& output)
+{
+	size_t consumed = 0;
+	while (size - consumed >= sizeof(uint32_t))
+	{
+		uint32_t recordSize;
+		std::memcpy(&recordSize, data + consumed, sizeof(recordSize));
+		if (recordSize < sizeof(uint32_t) || recordSize > size - consumed)
+		{
+			break;
+		}
+		Reader reader(data + consumed + sizeof(uint32_t), recordSize - sizeof(uint32_t));
+		const auto line = DecodeRecord(reader);
+		if (!line || !reader.AtEnd())
+		{
+			break;
+		}
+		output << *line << L'\n';
+		consumed += recordSize;
+	}
+	return consumed;
+}
+
+std::wstring TraceDecoder::Decode(const std::vector<uint8_t>& data)
+{
+	std::wostringstream output;
+	Decode(data.data(), data.size(), output);
+	return output.str();
+}
+
+std::optional<std::wstring> TraceDecoder::DecodeRecord(Reader& reader)
+{
+	TraceEventType type;
+	const auto depth = reader.ReadBytes(&type, sizeof(type)) ? reader.ReadNumber() : std::nullopt;
+	if (!depth)
+	{
+		return std::nullopt;
+	}
+	std::wstring line(*depth, L'\t');
+	switch (type)
+	{
+	case TraceEventType::FunctionEntry:
+	{
+		const auto identifier = reader.ReadString();
+		const auto arguments = identifier ? reader.ReadValues() : std::nullopt;
+		if (!arguments)
+		{
+			return std::nullopt;
+		}
+		return line + L"Function: " + *identifier + L" Arguments: " + *arguments;
+	}
+	case TraceEventType::FunctionFromVariable:
+	{
+		const auto arguments = reader.ReadValues();
+		if (!arguments)
+		{
+			return std::nullopt;
+		}
+		return line + L"Function from variable, Arguments: " + *arguments;
+	}
+	case TraceEventType::FunctionCallStatement:
+		return line + L"FunctionCallStatement";
+	case TraceEventType::ReturnWithoutValue:
+		return line + L"Return";
+	case TraceEventType::While:
+	case TraceEventType::Conditional:
+	case TraceEventType::Return:
+	{
+		const auto value = reader.ReadValue();
+		if (!value)
+		{
+			return std::nullopt;
+		}
+		const auto name = (type == TraceEventType::While) ? L"While " : (type == TraceEventType::Conditional) ? L"Conditional " : L"Return ";
+		return line + name + value->ToPrintString();
+	}
+	case TraceEventType::Declaration:
+	case TraceEventType::Assignment:
+	{
+		const auto identifier = reader.ReadString();
+		const auto value = identifier ? reader.ReadValue() : std::nullopt;
+		if (!value)
+		{
+			return std::nullopt;
+		}
+		const auto name = (type == TraceEventType::Declaration) ? L"Declaration " : L"Assignment ";
+		return line + name + *identifier + L" = " + value->ToPrintString();
+	}
+	case TraceEventType::DeclarationWithoutValue:
+	{
+		const auto identifier = reader.ReadString();
+		if (!identifier)
+		{
+			return std::nullopt;
+		}
+		return line + L"Declaration " + *identifier;
+	}
+	default:
+		return std::nullopt;
+	}
+}
+
+TraceDecoder::Reader::Reader(const uint8_t* const data, const size_t size) noexcept :
+	data(data), size(size)
+{
+}
+
+std::optional<uint32_t> TraceDecoder::Reader::ReadNumber() noexcept
+{
+	uint32_t number;
+	if (!ReadBytes(&number, sizeof(number)))
+	{
+		return std::nullopt;
+	}
+	return number;
+}
+
+std::optional<std::wstring> TraceDecoder::Reader::ReadString()
+{
+	const auto length = ReadNumber();
+	if (!length || *length > size / sizeof(uint32_t))
+	{
+		return std::nullopt;
+	}
+	std::wstring string(*length, L'\0');
+	for (auto& character : string)
+	{
+		character = static_cast<wchar_t>(*ReadNumber());
+	}
+	return string;
+}
+
+std::optional<Value> TraceDecoder::Reader::ReadValue()
+{
+	Tracer::ValueTag tag;
+	if (!ReadBytes(&tag, sizeof(tag)))
+	{
+		return std::nullopt;
+	}
+	switch (tag)
+	{
+	case Tracer::ValueTag::Bool:
+	{
+		uint8_t byte;
+		return ReadBytes(&byte, sizeof(byte)) ? std::optional<Value>(Value(byte != 0)) : std::nullopt;
+	}
+	case Tracer::ValueTag::Int:
+	{
+		int integer;
+		return ReadBytes(&integer, sizeof(integer)) ? std::optional<Value>(Value(integer)) : std::nullopt;
+	}
+	case Tracer::ValueTag::Float:
+	{
+		float floatingPoint;
+		return ReadBytes(&floatingPoint, sizeof(floatingPoint)) ? std::optional<Value>(Value(floatingPoint)) : std::nullopt;
+	}
+	case Tracer::ValueTag::String:
+	{
+		auto string = ReadString();
+		return string ? std::optional<Value>(Value(std::move(*string))) : std::nullopt;
+	}
+	case Tracer::ValueTag::Function:
+		return Value(Value::Function(nullptr, {}));
+	default:
+		return std::nullopt;
+	}
+}
+
+std::optional<std::wstring> TraceDecoder::Reader::ReadValues()
+{
+	const auto count = ReadNumber();
+	if (!count)
+	{
+		return std::nullopt;
+	}
+	std::wstring text;
+	for (uint32_t i = 0; i < *count; ++i)
+	{
+		const auto value = ReadValue();
+		if (!value)
+		{
+			return std::nullopt;
+		}
+		text += value->ToPrintString() + L" ";
+	}
+	return text;
+}
+
+bool TraceDecoder::Reader::ReadBytes(void* const destination, const size_t count) noexcept
+{
+	if (count > size)
+	{
+		return false;
+	}
+	std::memcpy(destination, data, count);
+	data += count;
+	size -= count;
+	return true;
+}
+
+bool TraceDecoder::Reader::AtEnd() const noexcept
+{
+	return size == 0;
+}
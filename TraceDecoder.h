@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Tracer.h"
+
+// Turns binary records written by Tracer back into the indented text trace.
+class TraceDecoder
+{
+public:
+	// Decodes whole records and returns number of consumed bytes, incomplete or malformed tail is left
+	static size_t Decode(const uint8_t* const data, const size_t size, std::wostream& output);
+	static std::wstring Decode(const std::vector<uint8_t>& data);
+
+private:
+	class Reader
+	{
+	public:
+		Reader(const uint8_t* const data, const size_t size) noexcept;
+		std::optional<uint32_t> ReadNumber() noexcept;
+		std::optional<std::wstring> ReadString();
+		std::optional<Value> ReadValue();
+		std::optional<std::wstring> ReadValues();
+		bool ReadBytes(void* const destination, const size_t count) noexcept;
+		bool AtEnd() const noexcept;
+
+	private:
+		const uint8_t* data;
+		size_t size;
+	};
+
+	static std::optional<std::wstring> DecodeRecord(Reader& reader);
+};
@@ -0,0 +1,53 @@
+#include "TraceRing.h"
+#include <algorithm>
+#include <cstring>
+
+TraceRing::TraceRing(const size_t minimalCapacity) :
+	capacity(1)
+{
+	while (capacity < minimalCapacity)
+	{
+		capacity <<= 1;
+	}
+	buffer = std::make_unique<uint8_t[]>(capacity);
+}
+
+bool TraceRing::Write(const uint8_t* const data, const size_t size) noexcept
+{
+	const auto currentHead = head.load(std::memory_order_relaxed);
+	const auto currentTail = tail.load(std::memory_order_acquire);
+	if (capacity - (currentHead - currentTail) < size)
+	{
+		droppedCount.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	const auto offset = currentHead & (capacity - 1);
+	const auto firstPart = std::min(size, capacity - offset);
+	std::memcpy(buffer.get() + offset, data, firstPart);
+	std::memcpy(buffer.get(), data + firstPart, size - firstPart);
+	head.store(currentHead + size, std::memory_order_release);
+	return true;
+}
+
+size_t TraceRing::Read(std::vector<uint8_t>& output)
+{
+	const auto currentTail = tail.load(std::memory_order_relaxed);
+	const auto currentHead = head.load(std::memory_order_acquire);
+	const auto size = currentHead - currentTail;
+	const auto offset = currentTail & (capacity - 1);
+	const auto firstPart = std::min(size, capacity - offset);
+	output.insert(output.end(), buffer.get() + offset, buffer.get() + offset + firstPart);
+	output.insert(output.end(), buffer.get(), buffer.get() + (size - firstPart));
+	tail.store(currentHead, std::memory_order_release);
+	return size;
+}
+
+size_t TraceRing::GetCapacity() const noexcept
+{
+	return capacity;
+}
+
+size_t TraceRing::GetDroppedCount() const noexcept
+{
+	return droppedCount.load(std::memory_order_relaxed);
+}
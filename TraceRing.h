@@ -0,0 +1,28 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Lock-free single producer, single consumer ring of trace records.
+// Producer never blocks: record which does not fit is dropped and counted.
+class TraceRing
+{
+public:
+	explicit TraceRing(const size_t minimalCapacity = size_t(1) << 20);
+
+	bool Write(const uint8_t* const data, const size_t size) noexcept;
+	// Appends every published record to output, returns number of bytes read
+	size_t Read(std::vector<uint8_t>& output);
+
+	size_t GetCapacity() const noexcept;
+	size_t GetDroppedCount() const noexcept;
+
+private:
+	std::unique_ptr<uint8_t[]> buffer;
+	size_t capacity;
+	alignas(64) std::atomic<size_t> head = 0;
+	alignas(64) std::atomic<size_t> tail = 0;
+	std::atomic<size_t> droppedCount = 0;
+};
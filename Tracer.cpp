@@ -0,0 +1,81 @@
+#include "Tracer.h"
+#include <cstring>
+
+static_assert(std::variant_size_v<decltype(Value::value)> == 5, "Tracer::ValueTag has to follow alternatives of Value");
+
+Tracer::Tracer(TraceRing& ring) noexcept :
+	ring(ring)
+{
+}
+
+void Tracer::Begin(const unsigned int depth, const TraceEventType type) noexcept
+{
+	record.clear();
+	Put(uint32_t(0));
+	PutBytes(&type, sizeof(type));
+	Put(static_cast<uint32_t>(depth));
+}
+
+void Tracer::Commit() noexcept
+{
+	const auto size = static_cast<uint32_t>(record.size());
+	std::memcpy(record.data(), &size, sizeof(size));
+	ring.Write(record.data(), record.size());
+}
+
+void Tracer::Put(const uint32_t number) noexcept
+{
+	PutBytes(&number, sizeof(number));
+}
+
+void Tracer::Put(const std::wstring& string) noexcept
+{
+	Put(static_cast<uint32_t>(string.size()));
+	for (const auto character : string)
+	{
+		Put(static_cast<uint32_t>(character));
+	}
+}
+
+void Tracer::Put(const Symbol& symbol) noexcept
+{
+	Put(symbol.GetName());
+}
+
+void Tracer::Put(const Value& value) noexcept
+{
+	const auto tag = static_cast<ValueTag>(value.value.index());
+	PutBytes(&tag, sizeof(tag));
+	if (const auto boolean = std::get_if<bool>(&value.value))
+	{
+		const uint8_t byte = *boolean ? 1 : 0;
+		PutBytes(&byte, sizeof(byte));
+	}
+	else if (const auto integer = std::get_if<int>(&value.value))
+	{
+		PutBytes(integer, sizeof(*integer));
+	}
+	else if (const auto floatingPoint = std::get_if<float>(&value.value))
+	{
+		PutBytes(floatingPoint, sizeof(*floatingPoint));
+	}
+	else if (const auto string = value.GetString())
+	{
+		Put(*string);
+	}
+}
+
+void Tracer::Put(const std::vector<Value>& values) noexcept
+{
+	Put(static_cast<uint32_t>(values.size()));
+	for (const auto& value : values)
+	{
+		Put(value);
+	}
+}
+
+void Tracer::PutBytes(const void* const data, const size_t size) noexcept
+{
+	const auto bytes = static_cast<const uint8_t*>(data);
+	record.insert(record.end(), bytes, bytes + size);
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "TraceRing.h"
+#include "Symbol.h"
+#include "Value.h"
+
+enum class TraceEventType : uint8_t
+{
+	FunctionEntry,
+	FunctionFromVariable,
+	FunctionCallStatement,
+	While,
+	Conditional,
+	Return,
+	ReturnWithoutValue,
+	Declaration,
+	DeclarationWithoutValue,
+	Assignment
+};
+
+// Encodes execution trace events as compact binary records written into TraceRing.
+// Record: uint32 size, uint8 event type, uint32 depth, then event fields in the order passed to Event.
+// Strings are uint32 length followed by uint32 code units, values are uint8 tag followed by their payload.
+class Tracer
+{
+public:
+#if defined(INTERPRETER_TRACING)
+	static constexpr bool compiledIn = true;
+#else
+	static constexpr bool compiledIn = false;
+#endif
+
+	enum class ValueTag : uint8_t
+	{
+		Bool,
+		Int,
+		Float,
+		String,
+		Function
+	};
+
+	explicit Tracer(TraceRing& ring) noexcept;
+
+	template<typename... Fields>
+	void Event(const unsigned int depth, const TraceEventType type, const Fields&... fields) noexcept
+	{
+		Begin(depth, type);
+		(Put(fields), ...);
+		Commit();
+	}
+
+private:
+	void Begin(const unsigned int depth, const TraceEventType type) noexcept;
+	void Commit() noexcept;
+	void Put(const uint32_t number) noexcept;
+	void Put(const std::wstring& string) noexcept;
+	void Put(const Symbol& symbol) noexcept;
+	void Put(const Value& value) noexcept;
+	void Put(const std::vector<Value>& values) noexcept;
+	void PutBytes(const void* const data, const size_t size) noexcept;
+
+	TraceRing& ring;
+	// Reused between events, so tracing allocates only while the longest record grows
+	std::vector<uint8_t> record;
+};
@@ -1,10 +1,154 @@
 #include "Value.h"
 #include <stdexcept>
+#include <array>
+#include <charconv>
+#include <cwctype>
+#include <functional>
+#include <limits>
 #include "ParserObjects\Core.h"
 #include "Interpreter.h"
 
+namespace
+{
+	// Indices of the alternatives of Value::value, used to address the dispatch tables
+	constexpr size_t BoolIndex = 0;
+	constexpr size_t IntIndex = 1;
+	constexpr size_t FloatIndex = 2;
+	constexpr size_t TypesCount = std::variant_size_v<decltype(Value::value)>;
+	static_assert(std::is_same_v<std::variant_alternative_t<BoolIndex, decltype(Value::value)>, bool>);
+	static_assert(std::is_same_v<std::variant_alternative_t<IntIndex, decltype(Value::value)>, int>);
+	static_assert(std::is_same_v<std::variant_alternative_t<FloatIndex, decltype(Value::value)>, float>);
+
+	template<typename Result>
+	using DispatchTable = std::array<std::array<Result(*)(const Value&, const Value&), TypesCount>, TypesCount>;
+
+	template<typename Result, typename Operation, typename Left, typename Right>
+	Result ApplyNumeric(const Value& lhs, const Value& rhs)
+	{
+		return Result(Operation()(std::get<Left>(lhs.value), std::get<Right>(rhs.value)));
+	}
+
+	// Every type pair starts at the generic conversion path, numeric pairs are then routed directly
+	template<typename Result, typename Operation>
+	DispatchTable<Result> MakeDispatchTable(Result(*withConversion)(const Value&, const Value&))
+	{
+		DispatchTable<Result> table;
+		for (auto& row : table)
+		{
+			row.fill(withConversion);
+		}
+		table[IntIndex][IntIndex] = &ApplyNumeric<Result, Operation, int, int>;
+		table[IntIndex][FloatIndex] = &ApplyNumeric<Result, Operation, int, float>;
+		table[FloatIndex][IntIndex] = &ApplyNumeric<Result, Operation, float, int>;
+		table[FloatIndex][FloatIndex] = &ApplyNumeric<Result, Operation, float, float>;
+		return table;
+	}
+
+	template<typename Operation>
+	DispatchTable<Value> MakeArithmeticTable(Value(*withConversion)(const Value&, const Value&))
+	{
+		return MakeDispatchTable<Value, Operation>(withConversion);
+	}
+
+	template<typename Operation>
+	DispatchTable<bool> MakeComparisonTable(bool(*withConversion)(const Value&, const Value&))
+	{
+		auto table = MakeDispatchTable<bool, Operation>(withConversion);
+		if constexpr (std::is_same_v<Operation, std::equal_to<>>)
+		{
+			table[BoolIndex][BoolIndex] = &ApplyNumeric<bool, Operation, bool, bool>;
+		}
+		return table;
+	}
+
+	constexpr size_t numberBufferSize = 64;
+
+	// Non throwing equivalent of std::stoi / std::stof requiring the whole string to be consumed.
+	// Numbers are plain ASCII, so the text is narrowed into a stack buffer and handed to std::from_chars.
+	template<typename Number>
+	std::optional<Number> ParseNumber(const std::wstring& str)
+	{
+		size_t begin = 0;
+		while (begin < str.size() && std::iswspace(str[begin]))
+		{
+			++begin;
+		}
+		bool negative = false;
+		if (begin < str.size() && (str[begin] == L'+' || str[begin] == L'-'))
+		{
+			negative = str[begin] == L'-';
+			++begin;
+		}
+
+		size_t length = str.size() - begin;
+		std::array<char, numberBufferSize> buffer;
+		std::string longText;
+		char* text = buffer.data();
+		if (length > buffer.size())
+		{
+			longText.resize(length);
+			text = longText.data();
+		}
+		for (size_t i = 0; i < length; ++i)
+		{
+			const auto character = str[begin + i];
+			if (static_cast<unsigned long>(character) > 0x7F)
+			{
+				return std::nullopt;
+			}
+			text[i] = static_cast<char>(character);
+		}
+
+		if constexpr (std::is_integral_v<Number>)
+		{
+			if (length == 0 || text[0] == '-')
+			{
+				return std::nullopt;
+			}
+			long long result;
+			const auto [end, error] = std::from_chars(text, text + length, result);
+			if (error != std::errc() || end != text + length)
+			{
+				return std::nullopt;
+			}
+			result = negative ? -result : result;
+			if (result < std::numeric_limits<Number>::min() || result > std::numeric_limits<Number>::max())
+			{
+				return std::nullopt;
+			}
+			return static_cast<Number>(result);
+		}
+		else
+		{
+			auto format = std::chars_format::general;
+			if (length > 1 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X'))
+			{
+				format = std::chars_format::hex;
+				text += 2;
+				length -= 2;
+			}
+			if (length == 0 || text[0] == '-')
+			{
+				return std::nullopt;
+			}
+			Number result;
+			const auto [end, error] = std::from_chars(text, text + length, result, format);
+			if (error != std::errc() || end != text + length)
+			{
+				return std::nullopt;
+			}
+			return negative ? -result : result;
+		}
+	}
+}
+
 Value::Value(const Function& function) noexcept :
-	value(function)
+	value(FunctionRef::Make(function))
+{
+}
+
+Value::Value(Function&& function) noexcept :
+	value(FunctionRef::Make(std::move(function)))
 {
 }
 
@@ -24,8 +168,61 @@ Value::Value(const float val) noexcept :
 }
 
 Value::Value(const std::wstring& val) noexcept :
-	value(val)
+	value(StringRef::Make(val))
+{
+}
+
+Value::Value(std::wstring&& val) noexcept :
+	value(StringRef::Make(std::move(val)))
+{
+}
+
+Value::Value(StringRef string) noexcept :
+	value(std::move(string))
+{
+}
+
+StringData::StringData(const std::wstring& text) :
+	text(text)
+{
+}
+
+StringData::StringData(std::wstring&& text) noexcept :
+	text(std::move(text))
+{
+}
+
+const std::wstring& StringData::GetText() const noexcept
+{
+	return text;
+}
+
+void StringData::Append(const std::wstring& suffix)
+{
+	text += suffix;
+	classified = false;
+}
+
+std::optional<int> StringData::AsInt() const
 {
+	Classify();
+	return intValue;
+}
+
+std::optional<float> StringData::AsFloat() const
+{
+	Classify();
+	return floatValue;
+}
+
+void StringData::Classify() const
+{
+	if (!classified)
+	{
+		intValue = Value::TryConvertToInt(text);
+		floatValue = Value::TryConvertToFloat(text);
+		classified = true;
+	}
 }
 
 std::wstring Value::ToString() const
@@ -42,20 +239,20 @@ std::wstring Value::ToString() const
 	{
 		return std::get<bool>(value) ? L"true" : L"false";
 	}
-	if (std::holds_alternative<std::wstring>(value))
+	if (std::holds_alternative<StringRef>(value))
 	{
-		return std::get<std::wstring>(value);
+		return std::get<StringRef>(value)->GetText();
 	}
 	throw ValueException("Cannot convert value to string");
 }
 
 std::wstring Value::ToPrintString() const
 {
-	if (std::holds_alternative<int>(value) || std::holds_alternative<float>(value) || std::holds_alternative<bool>(value) || std::holds_alternative<std::wstring>(value))
+	if (std::holds_alternative<int>(value) || std::holds_alternative<float>(value) || std::holds_alternative<bool>(value) || std::holds_alternative<StringRef>(value))
 	{
 		return ToString();
 	}
-	if (std::holds_alternative<Function>(value))
+	if (std::holds_alternative<FunctionRef>(value))
 	{
 		return L"Function";
 	}
@@ -68,21 +265,31 @@ bool Value::ToBool() const
 	{
 		return std::get<bool>(value);
 	}
-	if (std::holds_alternative<std::wstring>(value))
+	if (std::holds_alternative<StringRef>(value))
 	{
-		if (std::get<std::wstring>(value) == L"true" || std::get<std::wstring>(value) == L"false")
+		const auto& text = std::get<StringRef>(value)->GetText();
+		if (text == L"true" || text == L"false")
 		{
-			return std::get<std::wstring>(value) == L"true";
+			return text == L"true";
 		}
 	}
 	throw ValueException("Cannot convert value to bool");
 }
 
+const std::wstring* Value::GetString() const noexcept
+{
+	if (std::holds_alternative<StringRef>(value))
+	{
+		return &std::get<StringRef>(value)->GetText();
+	}
+	return nullptr;
+}
+
 const Value::Function* Value::GetFunction() const noexcept
 {
-	if (std::holds_alternative<Function>(value))
+	if (std::holds_alternative<FunctionRef>(value))
 	{
-		return &std::get<Function>(value);
+		return std::get<FunctionRef>(value).Get();
 	}
 	return nullptr;
 }
@@ -133,22 +340,20 @@ Value Value::operator+(const Value& other) const
 	{
 		return std::get<int>(value) + std::get<int>(other.value);
 	}
-	else if (std::holds_alternative<float>(value) && std::holds_alternative<float>(other.value))
+	if (std::holds_alternative<float>(value) && std::holds_alternative<float>(other.value))
 	{
 		return std::get<float>(value) + std::get<float>(other.value);
 	}
-	else if (std::holds_alternative<int>(value) && std::holds_alternative<float>(other.value))
-	{
-		return Value(static_cast<float>(std::get<int>(value)) + std::get<float>(other.value));
-	}
-	else if (std::holds_alternative<float>(value) && std::holds_alternative<int>(other.value))
-	{
-		return Value(std::get<float>(value) + static_cast<float>(std::get<int>(other.value)));
-	}
-	else if (std::holds_alternative<int>(value) && std::holds_alternative<std::wstring>(other.value))
+	static const auto dispatchTable = MakeArithmeticTable<std::plus<>>(&Value::AddWithConversion);
+	return dispatchTable[value.index()][other.value.index()](*this, other);
+}
+
+Value Value::AddWithConversion(const Value& lhs, const Value& rhs)
+{
+	if (std::holds_alternative<int>(lhs.value) && std::holds_alternative<StringRef>(rhs.value))
 	{
-		const auto& str = std::get<std::wstring>(other.value);
-		const auto integerValue = std::get<int>(value);
+		const auto& str = *std::get<StringRef>(rhs.value);
+		const auto integerValue = std::get<int>(lhs.value);
 		if (auto intValue = TryConvertToInt(str))
 		{
 			return Value(integerValue + *intValue);
@@ -157,12 +362,12 @@ Value Value::operator+(const Value& other) const
 		{
 			return Value(integerValue + *floatValue);
 		}
-		return Value(std::to_wstring(integerValue) + str);
+		return Value(std::to_wstring(integerValue) + str.GetText());
 	}
-	else if (std::holds_alternative<std::wstring>(value) && std::holds_alternative<int>(other.value))
+	else if (std::holds_alternative<StringRef>(lhs.value) && std::holds_alternative<int>(rhs.value))
 	{
-		const auto& str = std::get<std::wstring>(value);
-		const auto integerValue = std::get<int>(other.value);
+		const auto& str = *std::get<StringRef>(lhs.value);
+		const auto integerValue = std::get<int>(rhs.value);
 		if (auto intValue = TryConvertToInt(str))
 		{
 			return Value(integerValue + *intValue);
@@ -171,12 +376,12 @@ Value Value::operator+(const Value& other) const
 		{
 			return Value(integerValue + *floatValue);
 		}
-		return Value(str + std::to_wstring(integerValue));
+		return Value(str.GetText() + std::to_wstring(integerValue));
 	}
-	else if (std::holds_alternative<float>(value) && std::holds_alternative<std::wstring>(other.value))
+	else if (std::holds_alternative<float>(lhs.value) && std::holds_alternative<StringRef>(rhs.value))
 	{
-		const auto& str = std::get<std::wstring>(other.value);
-		const auto floatVal = std::get<float>(value);
+		const auto& str = *std::get<StringRef>(rhs.value);
+		const auto floatVal = std::get<float>(lhs.value);
 		if (auto intValue = TryConvertToInt(str))
 		{
 			return Value(floatVal + *intValue);
@@ -186,10 +391,10 @@ Value Value::operator+(const Value& other) const
 			return Value(floatVal + *floatValue);
 		}
 	}
-	else if (std::holds_alternative<std::wstring>(value) && std::holds_alternative<float>(other.value))
+	else if (std::holds_alternative<StringRef>(lhs.value) && std::holds_alternative<float>(rhs.value))
 	{
-		const auto& str = std::get<std::wstring>(value);
-		const auto floatVal = std::get<float>(other.value);
+		const auto& str = *std::get<StringRef>(lhs.value);
+		const auto floatVal = std::get<float>(rhs.value);
 		if (auto intValue = TryConvertToInt(str))
 		{
 			return Value(floatVal + *intValue);
@@ -199,49 +404,76 @@ Value Value::operator+(const Value& other) const
 			return Value(floatVal + *floatValue);
 		}
 	}
-	else if (std::holds_alternative<bool>(value) && std::holds_alternative<std::wstring>(other.value))
+	else if (std::holds_alternative<bool>(lhs.value) && std::holds_alternative<StringRef>(rhs.value))
 	{
-		return Value((std::get<bool>(value) ? L"true" : L"false") + std::get<std::wstring>(other.value));
+		return Value((std::get<bool>(lhs.value) ? L"true" : L"false") + std::get<StringRef>(rhs.value)->GetText());
 	}
-	else if (std::holds_alternative<std::wstring>(value) && std::holds_alternative<bool>(other.value))
+	else if (std::holds_alternative<StringRef>(lhs.value) && std::holds_alternative<bool>(rhs.value))
 	{
-		return Value(std::get<std::wstring>(value) + (std::get<bool>(value) ? L"true" : L"false"));
+		return Value(std::get<StringRef>(lhs.value)->GetText() + (std::get<bool>(rhs.value) ? L"true" : L"false"));
 	}
-	else if (std::holds_alternative<std::wstring>(value) && std::holds_alternative<std::wstring>(other.value))
+	else if (std::holds_alternative<StringRef>(lhs.value) && std::holds_alternative<StringRef>(rhs.value))
 	{
-		return std::get<std::wstring>(value) + std::get<std::wstring>(other.value);
+		return std::get<StringRef>(lhs.value)->GetText() + std::get<StringRef>(rhs.value)->GetText();
 	}
 	throw ValueException("Operator not supported for these value type.");
 }
 
 Value Value::operator+=(const Value& other)
 {
-	*this = *this + other;
+	if (!AppendInPlace(other))
+	{
+		*this = *this + other;
+	}
 	return *this;
 }
 
-Value Value::operator-(const Value& other) const
+// Concatenation onto uniquely owned string extends its buffer, so accumulating loops stay linear
+bool Value::AppendInPlace(const Value& other)
 {
-	if (std::holds_alternative<int>(value) && std::holds_alternative<int>(other.value))
+	const auto string = std::get_if<StringRef>(&value);
+	if (!string || !string->IsUnique())
 	{
-		return std::get<int>(value) - std::get<int>(other.value);
+		return false;
 	}
-	else if (std::holds_alternative<float>(value) && std::holds_alternative<float>(other.value))
+	if (const auto otherString = std::get_if<StringRef>(&other.value))
 	{
-		return std::get<float>(value) - std::get<float>(other.value);
+		(*string)->Append((*otherString)->GetText());
+		return true;
 	}
-	else if (std::holds_alternative<int>(value) && std::holds_alternative<float>(other.value))
+	if (const auto boolean = std::get_if<bool>(&other.value))
+	{
+		(*string)->Append(*boolean ? L"true" : L"false");
+		return true;
+	}
+	if (const auto integer = std::get_if<int>(&other.value); integer && !(*string)->AsInt() && !(*string)->AsFloat())
+	{
+		(*string)->Append(std::to_wstring(*integer));
+		return true;
+	}
+	return false;
+}
+
+Value Value::operator-(const Value& other) const
+{
+	if (std::holds_alternative<int>(value) && std::holds_alternative<int>(other.value))
 	{
-		return Value(static_cast<float>(std::get<int>(value)) - std::get<float>(other.value));
+		return std::get<int>(value) - std::get<int>(other.value);
 	}
-	else if (std::holds_alternative<float>(value) && std::holds_alternative<int>(other.value))
+	if (std::holds_alternative<float>(value) && std::holds_alternative<float>(other.value))
 	{
-		return Value(std::get<float>(value) - static_cast<float>(std::get<int>(other.value)));
+		return std::get<float>(value) - std::get<float>(other.value);
 	}
-	else if (std::holds_alternative<int>(value) && std::holds_alternative<std::wstring>(other.value))
+	static const auto dispatchTable = MakeArithmeticTable<std::minus<>>(&Value::SubtractWithConversion);
+	return dispatchTable[value.index()][other.value.index()](*this, other);
+}
+
+Value Value::SubtractWithConversion(const Value& lhs, const Value& rhs)
+{
+	if (std::holds_alternative<int>(lhs.value) && std::holds_alternative<StringRef>(rhs.value))
 	{
-		const auto& str = std::get<std::wstring>(other.value);
-		const auto integerValue = std::get<int>(value);
+		const auto& str = *std::get<StringRef>(rhs.value);
+		const auto integerValue = std::get<int>(lhs.value);
 		if (auto intValue = TryConvertToInt(str))
 		{
 			return Value(integerValue - *intValue);
@@ -251,10 +483,10 @@ Value Value::operator-(const Value& other) const
 			return Value(integerValue - *floatValue);
 		}
 	}
-	else if (std::holds_alternative<std::wstring>(value) && std::holds_alternative<int>(other.value))
+	else if (std::holds_alternative<StringRef>(lhs.value) && std::holds_alternative<int>(rhs.value))
 	{
-		const auto& str = std::get<std::wstring>(value);
-		const auto integerValue = std::get<int>(other.value);
+		const auto& str = *std::get<StringRef>(lhs.value);
+		const auto integerValue = std::get<int>(rhs.value);
 		if (auto intValue = TryConvertToInt(str))
 		{
 			return Value(integerValue - *intValue);
@@ -264,10 +496,10 @@ Value Value::operator-(const Value& other) const
 			return Value(integerValue - *floatValue);
 		}
 	}
-	else if (std::holds_alternative<float>(value) && std::holds_alternative<std::wstring>(other.value))
+	else if (std::holds_alternative<float>(lhs.value) && std::holds_alternative<StringRef>(rhs.value))
 	{
-		const auto& str = std::get<std::wstring>(other.value);
-		const auto floatVal = std::get<float>(value);
+		const auto& str = *std::get<StringRef>(rhs.value);
+		const auto floatVal = std::get<float>(lhs.value);
 		if (auto intValue = TryConvertToInt(str))
 		{
 			return Value(floatVal - *intValue);
@@ -277,10 +509,10 @@ Value Value::operator-(const Value& other) const
 			return Value(floatVal - *floatValue);
 		}
 	}
-	else if (std::holds_alternative<std::wstring>(value) && std::holds_alternative<float>(other.value))
+	else if (std::holds_alternative<StringRef>(lhs.value) && std::holds_alternative<float>(rhs.value))
 	{
-		const auto& str = std::get<std::wstring>(value);
-		const auto floatVal = std::get<float>(other.value);
+		const auto& str = *std::get<StringRef>(lhs.value);
+		const auto floatVal = std::get<float>(rhs.value);
 		if (auto intValue = TryConvertToInt(str))
 		{
 			return Value(floatVal - *intValue);
@@ -290,12 +522,12 @@ Value Value::operator-(const Value& other) const
 			return Value(floatVal - *floatValue);
 		}
 	}
-	else if (std::holds_alternative<std::wstring>(value) && std::holds_alternative<std::wstring>(other.value))
+	else if (std::holds_alternative<StringRef>(lhs.value) && std::holds_alternative<StringRef>(rhs.value))
 	{
-		const auto& str1 = std::get<std::wstring>(value);
+		const auto& str1 = *std::get<StringRef>(lhs.value);
 		const auto intVal1 = TryConvertToInt(str1);
 		const auto floatVal1 = TryConvertToFloat(str1);
-		const auto& str2 = std::get<std::wstring>(other.value);
+		const auto& str2 = *std::get<StringRef>(rhs.value);
 		const auto intVal2 = TryConvertToInt(str2);
 		const auto floatVal2 = TryConvertToFloat(str2);
 		if (intVal1)
@@ -336,22 +568,20 @@ Value Value::operator*(const Value& other) const
 	{
 		return std::get<int>(value) * std::get<int>(other.value);
 	}
-	else if (std::holds_alternative<float>(value) && std::holds_alternative<float>(other.value))
+	if (std::holds_alternative<float>(value) && std::holds_alternative<float>(other.value))
 	{
 		return std::get<float>(value) * std::get<float>(other.value);
 	}
-	else if (std::holds_alternative<int>(value) && std::holds_alternative<float>(other.value))
-	{
-		return Value(std::get<int>(value) * std::get<float>(other.value));
-	}
-	else if (std::holds_alternative<float>(value) && std::holds_alternative<int>(other.value))
-	{
-		return Value(std::get<float>(value) * std::get<int>(other.value));
-	}
-	else if (std::holds_alternative<int>(value) && std::holds_alternative<std::wstring>(other.value))
+	static const auto dispatchTable = MakeArithmeticTable<std::multiplies<>>(&Value::MultiplyWithConversion);
+	return dispatchTable[value.index()][other.value.index()](*this, other);
+}
+
+Value Value::MultiplyWithConversion(const Value& lhs, const Value& rhs)
+{
+	if (std::holds_alternative<int>(lhs.value) && std::holds_alternative<StringRef>(rhs.value))
 	{
-		const auto& str = std::get<std::wstring>(other.value);
-		const auto integerValue = std::get<int>(value);
+		const auto& str = *std::get<StringRef>(rhs.value);
+		const auto integerValue = std::get<int>(lhs.value);
 		if (auto intValue = TryConvertToInt(str))
 		{
 			return Value(integerValue * *intValue);
@@ -362,14 +592,14 @@ Value Value::operator*(const Value& other) const
 		}
 		if (integerValue >= 0)
 		{
-			return Value(MultiplyString(integerValue, str));
+			return Value(MultiplyString(integerValue, str.GetText()));
 		}
 		throw ValueException("Operator not supported for these value type.");
 	}
-	else if (std::holds_alternative<std::wstring>(value) && std::holds_alternative<int>(other.value))
+	else if (std::holds_alternative<StringRef>(lhs.value) && std::holds_alternative<int>(rhs.value))
 	{
-		const auto& str = std::get<std::wstring>(value);
-		const auto integerValue = std::get<int>(other.value);
+		const auto& str = *std::get<StringRef>(lhs.value);
+		const auto integerValue = std::get<int>(rhs.value);
 		if (auto intValue = TryConvertToInt(str))
 		{
 			return Value(integerValue * *intValue);
@@ -380,14 +610,14 @@ Value Value::operator*(const Value& other) const
 		}
 		if (integerValue >= 0)
 		{
-			return Value(MultiplyString(integerValue, str));
+			return Value(MultiplyString(integerValue, str.GetText()));
 		}
 		throw ValueException("Operator not supported for these value type.");
 	}
-	else if (std::holds_alternative<float>(value) && std::holds_alternative<std::wstring>(other.value))
+	else if (std::holds_alternative<float>(lhs.value) && std::holds_alternative<StringRef>(rhs.value))
 	{
-		const auto& str = std::get<std::wstring>(other.value);
-		const auto floatVal = std::get<float>(value);
+		const auto& str = *std::get<StringRef>(rhs.value);
+		const auto floatVal = std::get<float>(lhs.value);
 		if (auto intValue = TryConvertToInt(str))
 		{
 			return Value(floatVal * *intValue);
@@ -397,10 +627,10 @@ Value Value::operator*(const Value& other) const
 			return Value(floatVal * *floatValue);
 		}
 	}
-	else if (std::holds_alternative<std::wstring>(value) && std::holds_alternative<float>(other.value))
+	else if (std::holds_alternative<StringRef>(lhs.value) && std::holds_alternative<float>(rhs.value))
 	{
-		const auto& str = std::get<std::wstring>(value);
-		const auto floatVal = std::get<float>(other.value);
+		const auto& str = *std::get<StringRef>(lhs.value);
+		const auto floatVal = std::get<float>(rhs.value);
 		if (auto intValue = TryConvertToInt(str))
 		{
 			return Value(floatVal * *intValue);
@@ -410,12 +640,12 @@ Value Value::operator*(const Value& other) const
 			return Value(floatVal * *floatValue);
 		}
 	}
-	else if (std::holds_alternative<std::wstring>(value) && std::holds_alternative<std::wstring>(other.value))
+	else if (std::holds_alternative<StringRef>(lhs.value) && std::holds_alternative<StringRef>(rhs.value))
 	{
-		const auto& str1 = std::get<std::wstring>(value);
+		const auto& str1 = *std::get<StringRef>(lhs.value);
 		const auto intVal1 = TryConvertToInt(str1);
 		const auto floatVal1 = TryConvertToFloat(str1);
-		const auto& str2 = std::get<std::wstring>(other.value);
+		const auto& str2 = *std::get<StringRef>(rhs.value);
 		const auto intVal2 = TryConvertToInt(str2);
 		const auto floatVal2 = TryConvertToFloat(str2);
 		if (intVal1)
@@ -456,22 +686,20 @@ Value Value::operator/(const Value& other) const
 	{
 		return std::get<int>(value) / std::get<int>(other.value);
 	}
-	else if (std::holds_alternative<float>(value) && std::holds_alternative<float>(other.value))
+	if (std::holds_alternative<float>(value) && std::holds_alternative<float>(other.value))
 	{
 		return std::get<float>(value) / std::get<float>(other.value);
 	}
-	else if (std::holds_alternative<int>(value) && std::holds_alternative<float>(other.value))
-	{
-		return Value(std::get<int>(value) / std::get<float>(other.value));
-	}
-	else if (std::holds_alternative<float>(value) && std::holds_alternative<int>(other.value))
-	{
-		return Value(std::get<float>(value) / std::get<int>(other.value));
-	}
-	else if (std::holds_alternative<int>(value) && std::holds_alternative<std::wstring>(other.value))
+	static const auto dispatchTable = MakeArithmeticTable<std::divides<>>(&Value::DivideWithConversion);
+	return dispatchTable[value.index()][other.value.index()](*this, other);
+}
+
+Value Value::DivideWithConversion(const Value& lhs, const Value& rhs)
+{
+	if (std::holds_alternative<int>(lhs.value) && std::holds_alternative<StringRef>(rhs.value))
 	{
-		const auto& str = std::get<std::wstring>(other.value);
-		const auto integerValue = std::get<int>(value);
+		const auto& str = *std::get<StringRef>(rhs.value);
+		const auto integerValue = std::get<int>(lhs.value);
 		if (auto intValue = TryConvertToInt(str))
 		{
 			return Value(integerValue / *intValue);
@@ -481,10 +709,10 @@ Value Value::operator/(const Value& other) const
 			return Value(integerValue / *floatValue);
 		}
 	}
-	else if (std::holds_alternative<std::wstring>(value) && std::holds_alternative<int>(other.value))
+	else if (std::holds_alternative<StringRef>(lhs.value) && std::holds_alternative<int>(rhs.value))
 	{
-		const auto& str = std::get<std::wstring>(value);
-		const auto integerValue = std::get<int>(other.value);
+		const auto& str = *std::get<StringRef>(lhs.value);
+		const auto integerValue = std::get<int>(rhs.value);
 		if (auto intValue = TryConvertToInt(str))
 		{
 			return Value(integerValue / *intValue);
@@ -494,10 +722,10 @@ Value Value::operator/(const Value& other) const
 			return Value(integerValue / *floatValue);
 		}
 	}
-	else if (std::holds_alternative<float>(value) && std::holds_alternative<std::wstring>(other.value))
+	else if (std::holds_alternative<float>(lhs.value) && std::holds_alternative<StringRef>(rhs.value))
 	{
-		const auto& str = std::get<std::wstring>(other.value);
-		const auto floatVal = std::get<float>(value);
+		const auto& str = *std::get<StringRef>(rhs.value);
+		const auto floatVal = std::get<float>(lhs.value);
 		if (auto intValue = TryConvertToInt(str))
 		{
 			return Value(floatVal / *intValue);
@@ -507,10 +735,10 @@ Value Value::operator/(const Value& other) const
 			return Value(floatVal / *floatValue);
 		}
 	}
-	else if (std::holds_alternative<std::wstring>(value) && std::holds_alternative<float>(other.value))
+	else if (std::holds_alternative<StringRef>(lhs.value) && std::holds_alternative<float>(rhs.value))
 	{
-		const auto& str = std::get<std::wstring>(value);
-		const auto floatVal = std::get<float>(other.value);
+		const auto& str = *std::get<StringRef>(lhs.value);
+		const auto floatVal = std::get<float>(rhs.value);
 		if (auto intValue = TryConvertToInt(str))
 		{
 			return Value(floatVal / *intValue);
@@ -520,12 +748,12 @@ Value Value::operator/(const Value& other) const
 			return Value(floatVal / *floatValue);
 		}
 	}
-	else if (std::holds_alternative<std::wstring>(value) && std::holds_alternative<std::wstring>(other.value))
+	else if (std::holds_alternative<StringRef>(lhs.value) && std::holds_alternative<StringRef>(rhs.value))
 	{
-		const auto& str1 = std::get<std::wstring>(value);
+		const auto& str1 = *std::get<StringRef>(lhs.value);
 		const auto intVal1 = TryConvertToInt(str1);
 		const auto floatVal1 = TryConvertToFloat(str1);
-		const auto& str2 = std::get<std::wstring>(other.value);
+		const auto& str2 = *std::get<StringRef>(rhs.value);
 		const auto intVal2 = TryConvertToInt(str2);
 		const auto floatVal2 = TryConvertToFloat(str2);
 		if (intVal1)
@@ -566,49 +794,47 @@ bool Value::operator==(const Value& other) const
 	{
 		return std::get<int>(value) == std::get<int>(other.value);
 	}
-	if (std::holds_alternative<int>(value) && std::holds_alternative<float>(other.value))
-	{
-		return std::get<int>(value) == std::get<float>(other.value);
-	}
 	if (std::holds_alternative<float>(value) && std::holds_alternative<float>(other.value))
 	{
 		return std::get<float>(value) == std::get<float>(other.value);
 	}
-	if (std::holds_alternative<float>(value) && std::holds_alternative<int>(other.value))
-	{
-		return std::get<float>(value) == std::get<int>(other.value);
-	}
-	else if (std::holds_alternative<int>(value) && std::holds_alternative<std::wstring>(other.value))
+	static const auto dispatchTable = MakeComparisonTable<std::equal_to<>>(&Value::EqualWithConversion);
+	return dispatchTable[value.index()][other.value.index()](*this, other);
+}
+
+bool Value::EqualWithConversion(const Value& lhs, const Value& rhs)
+{
+	if (std::holds_alternative<int>(lhs.value) && std::holds_alternative<StringRef>(rhs.value))
 	{
-		return Compare(std::get<int>(value), std::get<std::wstring>(other.value));
+		return Compare(std::get<int>(lhs.value), *std::get<StringRef>(rhs.value));
 	}
-	else if (std::holds_alternative<std::wstring>(value) && std::holds_alternative<int>(other.value))
+	else if (std::holds_alternative<StringRef>(lhs.value) && std::holds_alternative<int>(rhs.value))
 	{
-		return Compare(std::get<int>(other.value), std::get<std::wstring>(value));
+		return Compare(std::get<int>(rhs.value), *std::get<StringRef>(lhs.value));
 	}
-	else if (std::holds_alternative<float>(value) && std::holds_alternative<std::wstring>(other.value))
+	else if (std::holds_alternative<float>(lhs.value) && std::holds_alternative<StringRef>(rhs.value))
 	{
-		return Compare(std::get<float>(value), std::get<std::wstring>(other.value));
+		return Compare(std::get<float>(lhs.value), *std::get<StringRef>(rhs.value));
 	}
-	else if (std::holds_alternative<std::wstring>(value) && std::holds_alternative<float>(other.value))
+	else if (std::holds_alternative<StringRef>(lhs.value) && std::holds_alternative<float>(rhs.value))
 	{
-		return Compare(std::get<float>(other.value), std::get<std::wstring>(value));
+		return Compare(std::get<float>(rhs.value), *std::get<StringRef>(lhs.value));
 	}
-	else if (std::holds_alternative<bool>(value) && std::holds_alternative<std::wstring>(other.value))
+	else if (std::holds_alternative<bool>(lhs.value) && std::holds_alternative<StringRef>(rhs.value))
 	{
-		return std::get<bool>(value) == other.ToBool();
+		return std::get<bool>(lhs.value) == rhs.ToBool();
 	}
-	else if (std::holds_alternative<std::wstring>(value) && std::holds_alternative<bool>(other.value))
+	else if (std::holds_alternative<StringRef>(lhs.value) && std::holds_alternative<bool>(rhs.value))
 	{
-		return std::get<bool>(other.value) == this->ToBool();
+		return std::get<bool>(rhs.value) == lhs.ToBool();
 	}
-	else if (std::holds_alternative<std::wstring>(value) && std::holds_alternative<std::wstring>(other.value))
+	else if (std::holds_alternative<StringRef>(lhs.value) && std::holds_alternative<StringRef>(rhs.value))
 	{
-		return std::get<std::wstring>(other.value) == std::get<std::wstring>(value);
+		return std::get<StringRef>(rhs.value)->GetText() == std::get<StringRef>(lhs.value)->GetText();
 	}
-	else if (std::holds_alternative<bool>(value) && std::holds_alternative<bool>(other.value))
+	else if (std::holds_alternative<bool>(lhs.value) && std::holds_alternative<bool>(rhs.value))
 	{
-		return std::get<bool>(other.value) == std::get<bool>(value);
+		return std::get<bool>(rhs.value) == std::get<bool>(lhs.value);
 	}
 	throw ValueException("Operator not supported for these value type.");
 }
@@ -624,68 +850,66 @@ bool Value::operator>(const Value& other) const
 	{
 		return std::get<int>(value) > std::get<int>(other.value);
 	}
-	if (std::holds_alternative<int>(value) && std::holds_alternative<float>(other.value))
-	{
-		return std::get<int>(value) > std::get<float>(other.value);
-	}
 	if (std::holds_alternative<float>(value) && std::holds_alternative<float>(other.value))
 	{
 		return std::get<float>(value) > std::get<float>(other.value);
 	}
-	if (std::holds_alternative<float>(value) && std::holds_alternative<int>(other.value))
-	{
-		return std::get<float>(value) > std::get<int>(other.value);
-	}
-	else if (std::holds_alternative<int>(value) && std::holds_alternative<std::wstring>(other.value))
+	static const auto dispatchTable = MakeComparisonTable<std::greater<>>(&Value::GreaterWithConversion);
+	return dispatchTable[value.index()][other.value.index()](*this, other);
+}
+
+bool Value::GreaterWithConversion(const Value& lhs, const Value& rhs)
+{
+	if (std::holds_alternative<int>(lhs.value) && std::holds_alternative<StringRef>(rhs.value))
 	{
-		if (auto intVal = TryConvertToInt(std::get<std::wstring>(other.value)))
+		if (auto intVal = TryConvertToInt(*std::get<StringRef>(rhs.value)))
 		{
-			return std::get<int>(value) > *intVal;
+			return std::get<int>(lhs.value) > *intVal;
 		}
-		if (auto floatVal = TryConvertToFloat(std::get<std::wstring>(other.value)))
+		if (auto floatVal = TryConvertToFloat(*std::get<StringRef>(rhs.value)))
 		{
-			return std::get<int>(value) > *floatVal;
+			return std::get<int>(lhs.value) > *floatVal;
 		}
 	}
-	else if (std::holds_alternative<std::wstring>(value) && std::holds_alternative<int>(other.value))
+	else if (std::holds_alternative<StringRef>(lhs.value) && std::holds_alternative<int>(rhs.value))
 	{
-		if (auto intVal = TryConvertToInt(std::get<std::wstring>(value)))
+		if (auto intVal = TryConvertToInt(*std::get<StringRef>(lhs.value)))
 		{
-			return std::get<int>(other.value) > *intVal;
+			return *intVal > std::get<int>(rhs.value);
 		}
-		if (auto floatVal = TryConvertToFloat(std::get<std::wstring>(other.value)))
+		if (auto floatVal = TryConvertToFloat(*std::get<StringRef>(lhs.value)))
 		{
-			return std::get<int>(other.value) > *floatVal;
+			return *floatVal > std::get<int>(rhs.value);
 		}
 	}
-	else if (std::holds_alternative<float>(value) && std::holds_alternative<std::wstring>(other.value))
+	else if (std::holds_alternative<float>(lhs.value) && std::holds_alternative<StringRef>(rhs.value))
 	{
-		if (auto intVal = TryConvertToInt(std::get<std::wstring>(other.value)))
+		if (auto intVal = TryConvertToInt(*std::get<StringRef>(rhs.value)))
 		{
-			return std::get<float>(value) > *intVal;
+			return std::get<float>(lhs.value) > *intVal;
 		}
-		if (auto floatVal = TryConvertToFloat(std::get<std::wstring>(other.value)))
+		if (auto floatVal = TryConvertToFloat(*std::get<StringRef>(rhs.value)))
 		{
-			return std::get<float>(value) > *floatVal;
+			return std::get<float>(lhs.value) > *floatVal;
 		}
 	}
-	else if (std::holds_alternative<std::wstring>(value) && std::holds_alternative<float>(other.value))
+	else if (std::holds_alternative<StringRef>(lhs.value) && std::holds_alternative<float>(rhs.value))
 	{
-		if (auto intVal = TryConvertToInt(std::get<std::wstring>(value)))
+		if (auto intVal = TryConvertToInt(*std::get<StringRef>(lhs.value)))
 		{
-			return std::get<float>(other.value) > *intVal;
+			return *intVal > std::get<float>(rhs.value);
 		}
-		if (auto floatVal = TryConvertToFloat(std::get<std::wstring>(other.value)))
+		if (auto floatVal = TryConvertToFloat(*std::get<StringRef>(lhs.value)))
 		{
-			return std::get<float>(other.value) > *floatVal;
+			return *floatVal > std::get<float>(rhs.value);
 		}
 	}
-	else if (std::holds_alternative<std::wstring>(value) && std::holds_alternative<std::wstring>(other.value))
+	else if (std::holds_alternative<StringRef>(lhs.value) && std::holds_alternative<StringRef>(rhs.value))
 	{
-		auto intVal1 = TryConvertToInt(std::get<std::wstring>(value));
-		auto intVal2 = TryConvertToInt(std::get<std::wstring>(other.value));
-		auto floatVal1 = TryConvertToFloat(std::get<std::wstring>(value));
-		auto floatVal2 = TryConvertToFloat(std::get<std::wstring>(other.value));
+		auto intVal1 = TryConvertToInt(*std::get<StringRef>(lhs.value));
+		auto intVal2 = TryConvertToInt(*std::get<StringRef>(rhs.value));
+		auto floatVal1 = TryConvertToFloat(*std::get<StringRef>(lhs.value));
+		auto floatVal2 = TryConvertToFloat(*std::get<StringRef>(rhs.value));
 
 		if (intVal1)
 		{
@@ -730,41 +954,35 @@ bool Value::operator<=(const Value& other) const
 
 std::optional<int> Value::TryConvertToInt(const std::wstring& str)
 {
-	try
-	{
-		size_t pos;
-		auto result = std::stoi(str, &pos);
-		if (pos == str.size())
-		{
-			return result;
-		}
-		return std::nullopt;
-	}
-	catch (...)
-	{
-		return std::nullopt;
-	}
+	return ParseNumber<int>(str);
 }
 
 std::optional<float> Value::TryConvertToFloat(const std::wstring& str)
 {
-	try
-	{
-		size_t pos;
-		auto result = std::stof(str, &pos);
-		if (pos == str.size())
-		{
-			return result;
-		}
-		return std::nullopt;
-	}
-	catch (...)
-	{
-		return std::nullopt;
-	}
+	return ParseNumber<float>(str);
+}
+
+std::optional<int> Value::TryConvertToInt(const StringData& str)
+{
+	return str.AsInt();
+}
+
+std::optional<float> Value::TryConvertToFloat(const StringData& str)
+{
+	return str.AsFloat();
 }
 
 bool Value::Compare(const int intVal, const std::wstring& str)
+{
+	return Compare(intVal, StringData(str));
+}
+
+bool Value::Compare(const float floatVal, const std::wstring& str)
+{
+	return Compare(floatVal, StringData(str));
+}
+
+bool Value::Compare(const int intVal, const StringData& str)
 {
 	if (auto intValue = TryConvertToInt(str))
 	{
@@ -777,7 +995,7 @@ bool Value::Compare(const int intVal, const std::wstring& str)
 	throw ValueException("String not convertible to number.");
 }
 
-bool Value::Compare(const float floatVal, const std::wstring& str)
+bool Value::Compare(const float floatVal, const StringData& str)
 {
 	// add better float comparison
 	if (auto intValue = TryConvertToInt(str))
@@ -812,27 +1030,27 @@ std::wstring Value::MultiplyString(const unsigned int count, const std::wstring&
 
 Value Value::operator>>(const Value& other) const
 {
-	if (std::holds_alternative<Function>(value) && std::holds_alternative<Function>(other.value))
+	if (std::holds_alternative<FunctionRef>(value) && std::holds_alternative<FunctionRef>(other.value))
 	{
-		if (std::get<Function>(other.value).parameters.size() > 1)
+		if (std::get<FunctionRef>(other.value)->parameters.size() > 1)
 		{
 			throw ValueException("Function that uses other in composition can have only one parameter");
 		}
-		auto func = std::get<Function>(other.value); 
-		func.composedOf = std::make_shared<Function>(std::get<Function>(value));
-		return Value(func);
+		auto func = *std::get<FunctionRef>(other.value); 
+		func.composedOf = std::make_shared<Function>(*std::get<FunctionRef>(value));
+		return Value(std::move(func));
 	}
 	throw ValueException("Only function value supports '>>' operator");
 }
 
 Value Value::operator<<(const std::vector<Value>& arguments) const
 {
-	if (std::holds_alternative<Function>(value))
+	if (std::holds_alternative<FunctionRef>(value))
 	{
-		auto func = std::get<Function>(value);
+		auto func = *std::get<FunctionRef>(value);
 		func.boundArguments.insert(func.boundArguments.end(), arguments.begin(), arguments.end());
 
-		return Value(func);
+		return Value(std::move(func));
 	}
 	throw ValueException("Only function value supports '<<' operator");
 }
\ No newline at end of file
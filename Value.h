@@ -4,6 +4,8 @@
 #include <optional>
 #include "Position.h"
 #include "InterpreterException.h"
+#include "RefPtr.h"
+#include "StringData.h"
 #include <vector>
 #include "ParserObjects\Core.h"
 #include "ParserObjects\Statements.h"
@@ -35,16 +37,26 @@ public:
 		}
 	};
 
+	using StringData = ::StringData;
+
+	// Strings and functions are shared between copies, so Value stays 16 bytes
+	using StringRef = RefPtr<StringData>;
+	using FunctionRef = RefPtr<Function>;
+
 	Value() = default;
 	Value(const Function& function) noexcept;
+	Value(Function&& function) noexcept;
 	Value(const bool val) noexcept;
 	Value(const int val) noexcept;
 	Value(const float val) noexcept;
 	Value(const std::wstring& val) noexcept;
-	std::variant<bool, int, float, std::wstring, Function> value;
+	Value(std::wstring&& val) noexcept;
+	Value(StringRef string) noexcept;
+	std::variant<bool, int, float, StringRef, FunctionRef> value;
 
 	std::wstring ToPrintString() const; // shouldn't be used when converting value to string just for debugging
 	bool ToBool() const;
+	const std::wstring* GetString() const noexcept;
 	const Function* GetFunction() const noexcept;
 
 	Value operator-() const;
@@ -73,11 +85,27 @@ public:
 	Value operator<<(const std::vector<Value>& arguments) const;
 
 protected:
+	// Payload classifies itself with the same conversions as Value
+	friend class ::StringData;
+
 	std::wstring ToString() const;
 	static std::optional<int> TryConvertToInt(const std::wstring& str);
 	static std::optional<float> TryConvertToFloat(const std::wstring& str);
+	static std::optional<int> TryConvertToInt(const StringData& str);
+	static std::optional<float> TryConvertToFloat(const StringData& str);
 	static bool Compare(const int intVal, const std::wstring& str);
 	static bool Compare(const float floatVal, const std::wstring& str);
+	static bool Compare(const int intVal, const StringData& str);
+	static bool Compare(const float floatVal, const StringData& str);
 	static bool Compare(const bool boolVal, const std::wstring& str);
 	static std::wstring MultiplyString(const unsigned int count, const std::wstring& str);
+	bool AppendInPlace(const Value& other);
+
+	// Slow paths of the binary operators, reached through the type pair dispatch tables
+	static Value AddWithConversion(const Value& lhs, const Value& rhs);
+	static Value SubtractWithConversion(const Value& lhs, const Value& rhs);
+	static Value MultiplyWithConversion(const Value& lhs, const Value& rhs);
+	static Value DivideWithConversion(const Value& lhs, const Value& rhs);
+	static bool EqualWithConversion(const Value& lhs, const Value& rhs);
+	static bool GreaterWithConversion(const Value& lhs, const Value& rhs);
 };
\ No newline at end of file
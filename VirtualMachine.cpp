@@ -0,0 +1,402 @@
+#include "VirtualMachine.h"
+#include <iostream>
+#include "BytecodeCompiler.h"
+#include "InterpreterException.h"
+#include "StringConversion.h"
+
+void VirtualMachine::Interpret(const Program* const program)
+{
+	BytecodeModule compiledModule;
+	try
+	{
+		compiledModule = BytecodeCompiler().Compile(program);
+	}
+	catch (const std::runtime_error& e)
+	{
+		std::cout << e.what();
+		return;
+	}
+	Execute(compiledModule);
+}
+
+void VirtualMachine::Execute(const BytecodeModule& module)
+{
+	this->module = &module;
+	stack.clear();
+	locals.clear();
+	lastReturnedValue = std::nullopt;
+	errorPosition = std::nullopt;
+	currentDepth = 0;
+	try
+	{
+		if (!module.mainFunction)
+		{
+			throw InterpreterException("Main function not found.", Position(0, 0));
+		}
+		CallFunctionDefinition(*module.mainFunction, {}, true);
+	}
+	catch (const Value::ValueException& ve)
+	{
+		const auto position = errorPosition.value_or(Position(0, 0));
+		std::cout << ve.what() << "[line:" << position.line << ", column : " << position.column << "] " << std::endl;
+	}
+	catch (const std::runtime_error& e)
+	{
+		std::cout << e.what();
+	}
+	this->module = nullptr;
+}
+
+void VirtualMachine::CallFunctionDefinition(const uint32_t functionIndex, std::vector<Value> arguments, const bool valueExpected)
+{
+	const auto& chunk = module->chunks[module->functionChunks[functionIndex]];
+	Trace(TraceEventType::FunctionEntry, chunk.name, arguments);
+	if (chunk.parameters.size() != arguments.size())
+	{
+		std::stringstream ss;
+		ss << "Function expects " << chunk.parameters.size() << " arguments, but got " << arguments.size() << ".";
+		throw InterpreterException(ss.str().c_str(), chunk.startingPosition);
+	}
+
+	const auto localsBase = locals.size();
+	locals.resize(localsBase + chunk.slotNames.size());
+	for (size_t i = 0; i < arguments.size(); ++i)
+	{
+		locals[localsBase + i] = std::move(arguments[i]);
+	}
+	Run(chunk, localsBase, valueExpected);
+	locals.resize(localsBase);
+}
+
+void VirtualMachine::CallFunctionValue(const Value::Function& function, std::vector<Value> arguments, const bool valueExpected, const Position position)
+{
+	auto allArguments = function.boundArguments;
+	allArguments.insert(allArguments.end(), std::make_move_iterator(arguments.begin()), std::make_move_iterator(arguments.end()));
+
+	const auto expectedParametersNum = (function.composedOf) ? (function.composedOf->parameters.size() - function.composedOf->boundArguments.size()) : function.parameters.size();
+	if (expectedParametersNum != allArguments.size())
+	{
+		std::stringstream ss;
+		ss << "Function expects " << function.parameters.size() << " arguments, but got " << allArguments.size() << ".";
+		throw InterpreterException(ss.str().c_str(), position);
+	}
+
+	if (function.composedOf)
+	{
+		CallFunctionValue(*function.composedOf, std::move(allArguments), true, position);
+		if (!lastReturnedValue)
+		{
+			throw InterpreterException("Function did not return any value", position);
+		}
+		allArguments.clear();
+		allArguments.push_back(*lastReturnedValue);
+	}
+
+	Trace(TraceEventType::FunctionFromVariable, allArguments);
+
+	const auto chunkIt = module->chunkByBlock.find(function.block);
+	if (chunkIt == module->chunkByBlock.end())
+	{
+		throw InterpreterException("Function definition not found.", position);
+	}
+	const auto& chunk = module->chunks[chunkIt->second];
+	if (allArguments.size() > chunk.parameters.size())
+	{
+		std::stringstream ss;
+		ss << "Function expects " << chunk.parameters.size() << " arguments, but got " << allArguments.size() << ".";
+		throw InterpreterException(ss.str().c_str(), position);
+	}
+
+	const auto localsBase = locals.size();
+	locals.resize(localsBase + chunk.slotNames.size());
+	for (size_t i = 0; i < allArguments.size(); ++i)
+	{
+		locals[localsBase + i] = std::move(allArguments[i]);
+	}
+	Run(chunk, localsBase, valueExpected);
+	locals.resize(localsBase);
+}
+
+void VirtualMachine::Run(const BytecodeChunk& chunk, const size_t localsBase, const bool valueExpected)
+{
+	const Instruction* const code = chunk.code.data();
+	size_t ip = 0;
+	try
+	{
+		while (true)
+		{
+			const auto instruction = code[ip++];
+			switch (instruction.opCode)
+			{
+			case OpCode::PushConstant:
+				stack.push_back(module->constants[instruction.operand]);
+				break;
+			case OpCode::PushFalse:
+				stack.push_back(Value(false));
+				break;
+			case OpCode::PushTrue:
+				stack.push_back(Value(true));
+				break;
+			case OpCode::Pop:
+				stack.pop_back();
+				break;
+			case OpCode::LoadLocal:
+			{
+				const auto& local = locals[localsBase + instruction.operand];
+				if (!local)
+				{
+					std::stringstream ss;
+					ss << "Variable '" << StringConversion::ToNarrow(chunk.slotNames[instruction.operand].GetName()) << "' does not have value.";
+					throw InterpreterException(ss.str().c_str(), chunk.positions[ip - 1]);
+				}
+				stack.push_back(*local);
+				break;
+			}
+			case OpCode::LoadLocalBindable:
+			{
+				const auto& local = locals[localsBase + instruction.operand];
+				if (!local)
+				{
+					throw InterpreterException("Variable does not have value.", chunk.positions[ip - 1]);
+				}
+				stack.push_back(*local);
+				break;
+			}
+			case OpCode::LoadCallee:
+			{
+				const auto& local = locals[localsBase + instruction.operand];
+				if (!local || !local->GetFunction())
+				{
+					throw InterpreterException("Function definition not found.", chunk.positions[ip - 1]);
+				}
+				stack.push_back(*local);
+				break;
+			}
+			case OpCode::DeclareLocal:
+			{
+				auto& local = locals[localsBase + instruction.operand];
+				local = Pop();
+				Trace(TraceEventType::Declaration, chunk.slotNames[instruction.operand], *local);
+				break;
+			}
+			case OpCode::DeclareLocalEmpty:
+				locals[localsBase + instruction.operand] = std::nullopt;
+				Trace(TraceEventType::DeclarationWithoutValue, chunk.slotNames[instruction.operand]);
+				break;
+			case OpCode::AssignLocal:
+			{
+				auto& local = locals[localsBase + instruction.operand];
+				local = Pop();
+				Trace(TraceEventType::Assignment, chunk.slotNames[instruction.operand], *local);
+				break;
+			}
+			case OpCode::LoadFunction:
+			{
+				const auto& functionChunk = module->chunks[module->functionChunks[instruction.operand]];
+				stack.push_back(Value(Value::Function(functionChunk.block, functionChunk.parameters)));
+				break;
+			}
+			case OpCode::MakeFunction:
+			{
+				const auto& functionChunk = module->chunks[instruction.operand];
+				stack.push_back(Value(Value::Function(functionChunk.block, functionChunk.parameters)));
+				break;
+			}
+			case OpCode::Negate:
+				stack.back() = -stack.back();
+				break;
+			case OpCode::Not:
+				stack.back() = !stack.back();
+				break;
+			case OpCode::Add:
+			{
+				const auto rhs = Pop();
+				stack.back() += rhs;
+				break;
+			}
+			case OpCode::Subtract:
+			{
+				const auto rhs = Pop();
+				stack.back() -= rhs;
+				break;
+			}
+			case OpCode::Multiply:
+			{
+				const auto rhs = Pop();
+				stack.back() *= rhs;
+				break;
+			}
+			case OpCode::Divide:
+			{
+				const auto rhs = Pop();
+				stack.back() /= rhs;
+				break;
+			}
+			case OpCode::Equal:
+			{
+				const auto rhs = Pop();
+				stack.back() = Value(stack.back() == rhs);
+				break;
+			}
+			case OpCode::NotEqual:
+			{
+				const auto rhs = Pop();
+				stack.back() = Value(stack.back() != rhs);
+				break;
+			}
+			case OpCode::Greater:
+			{
+				const auto rhs = Pop();
+				stack.back() = Value(stack.back() > rhs);
+				break;
+			}
+			case OpCode::GreaterEqual:
+			{
+				const auto rhs = Pop();
+				stack.back() = Value(stack.back() >= rhs);
+				break;
+			}
+			case OpCode::Less:
+			{
+				const auto rhs = Pop();
+				stack.back() = Value(stack.back() < rhs);
+				break;
+			}
+			case OpCode::LessEqual:
+			{
+				const auto rhs = Pop();
+				stack.back() = Value(stack.back() <= rhs);
+				break;
+			}
+			case OpCode::OrStep:
+			{
+				const auto rhs = Pop();
+				stack.back() |= rhs;
+				break;
+			}
+			case OpCode::AndStep:
+			{
+				const auto rhs = Pop();
+				stack.back() &= rhs;
+				break;
+			}
+			case OpCode::Compose:
+			{
+				const auto rhs = Pop();
+				stack.back() = stack.back() >> rhs;
+				break;
+			}
+			case OpCode::Bind:
+			{
+				const auto arguments = PopArguments(instruction.operand);
+				stack.back() = stack.back() << arguments;
+				break;
+			}
+			case OpCode::CallNamed:
+			{
+				auto arguments = PopArguments(BytecodeCall::ArgumentsCount(instruction.operand));
+				CallFunctionDefinition(BytecodeCall::Target(instruction.operand), std::move(arguments), BytecodeCall::ValueExpected(instruction.operand));
+				break;
+			}
+			case OpCode::CallValue:
+			{
+				auto arguments = PopArguments(BytecodeCall::ArgumentsCount(instruction.operand));
+				const auto callee = Pop();
+				CallFunctionValue(*callee.GetFunction(), std::move(arguments), BytecodeCall::ValueExpected(instruction.operand), chunk.positions[ip - 1]);
+				break;
+			}
+			case OpCode::PushReturnValue:
+				if (!lastReturnedValue)
+				{
+					throw InterpreterException("Function did not return any value", calleeEndPosition);
+				}
+				stack.push_back(*lastReturnedValue);
+				break;
+			case OpCode::Jump:
+				ip = instruction.operand;
+				break;
+			case OpCode::JumpIfTrue:
+				if (stack.back().ToBool())
+				{
+					ip = instruction.operand;
+				}
+				break;
+			case OpCode::JumpIfFalse:
+				if (!stack.back().ToBool())
+				{
+					ip = instruction.operand;
+				}
+				break;
+			case OpCode::BranchIfFalse:
+				if (!Pop().ToBool())
+				{
+					ip = instruction.operand;
+				}
+				break;
+			case OpCode::JumpIfValueNotExpected:
+				if (!valueExpected)
+				{
+					ip = instruction.operand;
+				}
+				break;
+			case OpCode::SetReturnValue:
+				lastReturnedValue = Pop();
+				Trace(TraceEventType::Return, *lastReturnedValue);
+				break;
+			case OpCode::ReturnNoValue:
+				lastReturnedValue = std::nullopt;
+				Trace(TraceEventType::ReturnWithoutValue);
+				break;
+			case OpCode::EnterBlock:
+				++currentDepth;
+				break;
+			case OpCode::LeaveBlock:
+				--currentDepth;
+				break;
+			case OpCode::TraceCallStatement:
+				Trace(TraceEventType::FunctionCallStatement);
+				break;
+			case OpCode::TraceConditional:
+				Trace(TraceEventType::Conditional, stack.back());
+				break;
+			case OpCode::TraceWhile:
+				Trace(TraceEventType::While, stack.back());
+				break;
+			case OpCode::Throw:
+				throw InterpreterException(module->messages[instruction.operand].c_str(), chunk.positions[ip - 1]);
+			case OpCode::End:
+				calleeEndPosition = chunk.positions[ip - 1];
+				return;
+			default:
+				throw InterpreterException("Unknown instruction.", chunk.positions[ip - 1]);
+			}
+		}
+	}
+	catch (const Value::ValueException&)
+	{
+		if (!errorPosition)
+		{
+			errorPosition = chunk.positions[ip - 1];
+		}
+		throw;
+	}
+}
+
+std::vector<Value> VirtualMachine::PopArguments(const uint32_t count)
+{
+	std::vector<Value> arguments(std::make_move_iterator(stack.end() - count), std::make_move_iterator(stack.end()));
+	stack.resize(stack.size() - count);
+	return arguments;
+}
+
+Value VirtualMachine::Pop()
+{
+	auto value = std::move(stack.back());
+	stack.pop_back();
+	return value;
+}
+
+void VirtualMachine::SetTracer(Tracer* const tracer) noexcept
+{
+	this->tracer = tracer;
+}
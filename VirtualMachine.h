@@ -0,0 +1,44 @@
+#pragma once
+#include "Bytecode.h"
+#include "ParserObjects/ParserObjects.h"
+#include "Tracer.h"
+
+// Stack based executor of BytecodeModule, alternative to the tree-walking Interpreter.
+class VirtualMachine
+{
+public:
+	void Interpret(const Program* const program);
+	void Execute(const BytecodeModule& module);
+	// Execution trace is recorded only while tracer is set
+	void SetTracer(Tracer* const tracer) noexcept;
+
+protected:
+	void CallFunctionDefinition(const uint32_t functionIndex, std::vector<Value> arguments, const bool valueExpected);
+	void CallFunctionValue(const Value::Function& function, std::vector<Value> arguments, const bool valueExpected, const Position position);
+	void Run(const BytecodeChunk& chunk, const size_t localsBase, const bool valueExpected);
+
+	std::vector<Value> PopArguments(const uint32_t count);
+	Value Pop();
+	template<typename... Fields>
+	void Trace(const TraceEventType type, const Fields&... fields) noexcept
+	{
+		if constexpr (Tracer::compiledIn)
+		{
+			if (tracer)
+			{
+				tracer->Event(currentDepth, type, fields...);
+			}
+		}
+	}
+
+private:
+	const BytecodeModule* module = nullptr;
+	std::vector<Value> stack;
+	std::vector<std::optional<Value>> locals;
+	std::optional<Value> lastReturnedValue = std::nullopt;
+	std::optional<Position> errorPosition = std::nullopt;
+	// Where the last finished function ended, missing return value is reported there as the Interpreter does
+	Position calleeEndPosition = Position(0, 0);
+	unsigned int currentDepth = 0;
+	Tracer* tracer = nullptr;
+};